@@ -0,0 +1,243 @@
+#ifndef HDF5PP_ASYNCFILE_H
+#define HDF5PP_ASYNCFILE_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Classes AsyncToken, AsyncFile and AsyncDataSet.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/DataSet.h"
+#include "hdf5pp/File.h"
+#include "hdf5pp/Type.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+class AsyncDataSet;
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Completion token for asynchronous store request.
+ *
+ *  Default-constructed token is not associated with any request and is
+ *  always complete.
+ *
+ *  @see AsyncFile
+ *
+ *  @version $Id$
+ */
+
+class AsyncToken  {
+public:
+
+  // Default constructor, makes completed token
+  AsyncToken() {}
+
+  /// Returns true if request has been executed (successfully or not)
+  bool done() const;
+
+  /**
+   *  @brief Wait until request is executed.
+   *
+   *  @throw hdf5pp::Exception if request has failed
+   */
+  void wait() const;
+
+  // returns true if there is a real object behind
+  bool valid() const { return m_state.get(); }
+
+private:
+
+  friend class AsyncFile;
+  friend class AsyncDataSet;
+
+  struct State;
+
+  // Data members
+  boost::shared_ptr<State> m_state;
+
+};
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Write-behind queue for a file.
+ *
+ *  Store requests for the datasets of a file are queued and executed in order
+ *  by a dedicated I/O thread, caller only waits when the total size of queued
+ *  data exceeds the limit given to constructor. Method drain() is a barrier
+ *  which waits until all queued requests are executed. Destructor of the last
+ *  copy of AsyncFile (and of all AsyncDataSet objects made from it) drains
+ *  the queue and stops the thread.
+ *
+ *  HDF5 calls are made from the I/O thread. Unless HDF5 library is built with
+ *  thread-safety enabled other threads must not use HDF5 while there are
+ *  pending requests; requests themselves are described by plain offsets and
+ *  dimensions so that queueing does not need HDF5 calls. Datasets used through
+ *  AsyncDataSet must not be used directly until the queue is drained.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see AsyncDataSet
+ *
+ *  @version $Id$
+ */
+
+class AsyncFile  {
+public:
+
+  // Default constructor, makes non-valid object
+  AsyncFile() {}
+
+  /**
+   *  @brief Start I/O thread for a file.
+   *
+   *  @param[in] file      File object, it is kept open while requests are pending.
+   *  @param[in] maxBytes  Limit on the total size of queued data.
+   */
+  explicit AsyncFile(const File& file, size_t maxBytes = 64*1024*1024);
+
+  // Destructor
+  ~AsyncFile() ;
+
+  /**
+   *  @brief Make asynchronous interface for a dataset.
+   *
+   *  @param[in] ds          Dataset object, must belong to this file.
+   *  @param[in] native_type In-memory type of the data which will be stored.
+   */
+  AsyncDataSet dataSet(const DataSet& ds, const Type& native_type);
+
+  /**
+   *  @brief Wait until all queued requests are executed.
+   *
+   *  @throw hdf5pp::Exception if any request has failed since last drain()
+   */
+  void drain();
+
+  /// Get total size of the data in the queue
+  size_t queuedBytes() const;
+
+  // returns true if there is a real object behind
+  bool valid() const { return m_impl.get(); }
+
+private:
+
+  friend class AsyncDataSet;
+
+  struct Request;
+  struct Impl;
+
+  // Data members
+  boost::shared_ptr<Impl> m_impl;
+
+};
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Asynchronous interface to a dataset.
+ *
+ *  All store methods queue request and return immediately. Data can be passed
+ *  either as a shared pointer which is kept until request is executed or as a
+ *  plain pointer, in which case data are copied.
+ *
+ *  @see AsyncFile
+ *
+ *  @version $Id$
+ */
+
+class AsyncDataSet  {
+public:
+
+  // Default constructor, makes non-valid object
+  AsyncDataSet() {}
+
+  /**
+   *  @brief Append records to the end of rank-1 dataset.
+   *
+   *  @param[in] data   Records, count objects of the type given to AsyncFile::dataSet().
+   *  @param[in] count  Number of records.
+   */
+  AsyncToken append(const boost::shared_ptr<const void>& data, hsize_t count);
+
+  /// Append records to the end of rank-1 dataset, data are copied.
+  AsyncToken appendCopy(const void* data, hsize_t count);
+
+  /**
+   *  @brief Store array in a hyperslab of a dataset.
+   *
+   *  @param[in] data    Array data in C order.
+   *  @param[in] offset  Position of array in dataset.
+   *  @param[in] dims    Array dimensions, same rank as dataset.
+   */
+  AsyncToken store(const boost::shared_ptr<const void>& data, const hsize_t offset[], const hsize_t dims[]);
+
+  /// Store array in a hyperslab of a dataset, data are copied.
+  AsyncToken storeCopy(const void* data, const hsize_t offset[], const hsize_t dims[]);
+
+  /**
+   *  @brief Wait until all requests for this dataset are executed.
+   *
+   *  @throw hdf5pp::Exception if last request has failed
+   */
+  void flush() { m_last.wait(); }
+
+  /// Get dataset object
+  DataSet dataSet() const { return m_ds; }
+
+  // returns true if there is a real object behind
+  bool valid() const { return m_file.get(); }
+
+private:
+
+  friend class AsyncFile;
+
+  // Constructor
+  AsyncDataSet(const boost::shared_ptr<AsyncFile::Impl>& file, const DataSet& ds, const Type& native_type);
+
+  // make request and queue it
+  AsyncToken queue(const boost::shared_ptr<const void>& data, const void* copy, bool append,
+      const hsize_t offset[], const hsize_t dims[]);
+
+  // Data members
+  boost::shared_ptr<AsyncFile::Impl> m_file;
+  DataSet m_ds;
+  Type m_type;
+  size_t m_typeSize;
+  unsigned m_rank;
+  AsyncToken m_last;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_ASYNCFILE_H
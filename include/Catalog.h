@@ -0,0 +1,173 @@
+#ifndef HDF5PP_CATALOG_H
+#define HDF5PP_CATALOG_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class Catalog.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/PathCache.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+class File;
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief In-memory catalog of all objects in one or more files.
+ *
+ *  Catalog is built by scan() which visits the whole hierarchy of a file once
+ *  with H5Ovisit(), for every object it records absolute path and object
+ *  type and token and for datasets also data type class and size, dataspace dimensions,
+ *  chunk dimensions, filters and storage size. Objects reachable through
+ *  several hard links are recorded once, soft links are not followed.
+ *
+ *  Catalog is immutable, objects are kept in a single array with dimensions
+ *  and filters in shared pools, lookups by path use a hash index. Catalog
+ *  objects have reference semantics, copies share the same data. Catalogs
+ *  of several files are combined with merge(), scan() for a list of files
+ *  scans them concurrently in separate processes (HDF5 library serializes
+ *  all calls even when it is thread-safe) and merges the results.
+ *
+ *  Catalogs can be written to and read from a stream in a compact binary
+ *  format, format uses native byte order and is only meant for the same
+ *  platform.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @version $Id$
+ */
+
+class Catalog  {
+public:
+
+  /// Description of one object
+  struct Object {
+    std::string path;         ///< Absolute path of the object
+    uint32_t file;            ///< Index of the file in files()
+    H5O_type_t type;          ///< Object type
+    PathCache::Token token;   ///< Object token (object header address before HDF5 1.12)
+    H5T_class_t typeClass;    ///< Data type class for datasets, H5T_NO_CLASS for other objects
+    uint32_t typeSize;        ///< Data type size for datasets
+    uint8_t rank;             ///< Dataspace rank for datasets
+    uint8_t nFilters;         ///< Number of filters for datasets
+    bool chunked;             ///< True for chunked datasets
+    uint32_t dimsIdx;         ///< Index of dimensions (and chunk dimensions) in dimensions pool
+    uint32_t filtersIdx;      ///< Index of filters in filters pool
+    uint64_t storageSize;     ///< Dataset storage size in bytes
+  };
+
+  /// Default constructor makes empty catalog
+  Catalog() ;
+
+  // Destructor
+  ~Catalog () ;
+
+  /**
+   *  @brief Scan all objects in a file.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Catalog scan(const File& file);
+
+  /**
+   *  @brief Scan many files concurrently and merge the catalogs.
+   *
+   *  Each file is scanned in a separate child process, at most nWorkers
+   *  processes run at the same time, if nWorkers is zero then number of
+   *  hardware threads is used. With one worker or one file files are scanned
+   *  in this process. Processes are made with fork(), this method should not
+   *  be called while other threads use HDF5 library.
+   *
+   *  @throw hdf5pp::Exception if any of the files cannot be scanned
+   */
+  static Catalog scan(const std::vector<std::string>& paths, unsigned nWorkers = 0);
+
+  /// Merge catalogs, files of all catalogs are listed in the same order.
+  static Catalog merge(const std::vector<Catalog>& catalogs);
+
+  /**
+   *  @brief Read catalog written by write().
+   *
+   *  Data are validated while reading: counts and sizes are checked against
+   *  the remaining stream size before memory is allocated (for streams which
+   *  support seeking), file, dimension and filter indices of all objects are
+   *  checked against the pool sizes.
+   *
+   *  @throw hdf5pp::Exception if stream does not contain valid catalog
+   */
+  static Catalog read(std::istream& in);
+
+  /// Write catalog to a stream.
+  void write(std::ostream& out) const;
+
+  /// Get names of the scanned files
+  const std::vector<std::string>& files() const;
+
+  /// Get number of objects
+  size_t size() const;
+
+  /// Get object by index, objects of each file are sorted by path.
+  const Object& object(size_t i) const;
+
+  /// Find object by path, returns zero pointer if object is not in catalog.
+  const Object* find(const std::string& path, uint32_t file = 0) const;
+
+  /// Get dataspace dimensions of a dataset
+  std::vector<hsize_t> dims(const Object& obj) const;
+
+  /// Get chunk dimensions of a dataset, empty for datasets which are not chunked
+  std::vector<hsize_t> chunkDims(const Object& obj) const;
+
+  /// Get filters of a dataset
+  std::vector<H5Z_filter_t> filters(const Object& obj) const;
+
+protected:
+
+private:
+
+  struct Data;
+
+  // Constructor
+  Catalog(const boost::shared_ptr<const Data>& data) : m_data(data) {}
+
+  // Data members
+  boost::shared_ptr<const Data> m_data;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_CATALOG_H
@@ -0,0 +1,141 @@
+#ifndef HDF5PP_CHUNKREADER_H
+#define HDF5PP_CHUNKREADER_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class ChunkReader.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <algorithm>
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/DataSet.h"
+#include "hdf5pp/Exceptions.h"
+#include "hdf5pp/Type.h"
+#include "hdf5pp/TypeTraits.h"
+#include "ndarray/ndarray.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Parallel decompression of chunked datasets.
+ *
+ *  This is the reading counterpart of ChunkWriter. Raw chunks are read with
+ *  DataSet::readChunk() one after another by the calling thread, they are
+ *  decompressed (see FilterPipeline::decode()) and copied into destination
+ *  array by a pool of worker threads. Chunks which have no storage allocated
+ *  are read with regular H5Dread() to get correct fill values.
+ *
+ *  Parallel read is only possible for chunked datasets with filters supported
+ *  by FilterPipeline and when in-memory type is the same as dataset type (no
+ *  conversion, no variable-length data). In all other cases read() falls back
+ *  to a single H5Dread() for the whole dataset, so it can be used with any
+ *  dataset. For rank-1 extensible datasets only logical size is read (see
+ *  DataSet::set_reserve()).
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see ChunkWriter
+ *  @see Utils::readNdarrayParallel
+ *
+ *  @version $Id$
+ */
+
+class ChunkReader  {
+public:
+
+  // Default constructor, makes non-valid reader
+  ChunkReader() {}
+
+  /**
+   *  @brief Make reader for a dataset.
+   *
+   *  @param[in] ds          Dataset.
+   *  @param[in] nThreads    Number of decompression threads, 0 means number of CPU cores.
+   *  @param[in] maxPending  Max. number of chunks in flight, 0 means four per thread.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  explicit ChunkReader(const DataSet& ds, unsigned nThreads = 0, unsigned maxPending = 0);
+
+  // Destructor
+  ~ChunkReader() ;
+
+  /// Returns true if data of given in-memory type can be read in parallel
+  bool supported(const Type& native_type) const;
+
+  /// Get dimensions of the data returned by read(), returns dataset rank
+  unsigned dimensions(hsize_t dims[]) const;
+
+  /**
+   *  @brief Read whole dataset.
+   *
+   *  @param[out] data        Buffer for the data in C order, its size must be at
+   *                          least the product of dimensions().
+   *  @param[in]  native_type In-memory type of data.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void read(void* data, const Type& native_type);
+
+  /// Read whole dataset into new ndarray, ndarray rank must be the same as dataset rank.
+  template <typename T, unsigned Rank>
+  ndarray<T, Rank> read(const Type& native_type = TypeTraits<T>::native_type()) {
+    hsize_t dims[H5S_MAX_RANK];
+    unsigned rank = dimensions(dims);
+    if (rank != Rank) throw Hdf5RankMismatch(ERR_LOC, Rank, rank);
+    unsigned shape[Rank];
+    std::copy(dims, dims+Rank, shape);
+    ndarray<T, Rank> array(shape);
+    if (array.size() > 0) read(static_cast<void*>(array.data()), native_type);
+    return array;
+  }
+
+  /// Get dataset object
+  DataSet dataSet() const;
+
+  // returns true if there is a real object behind
+  bool valid() const { return m_impl.get(); }
+
+protected:
+
+private:
+
+  struct Impl;
+
+  // Data members
+  boost::shared_ptr<Impl> m_impl;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_CHUNKREADER_H
@@ -0,0 +1,156 @@
+#ifndef HDF5PP_CHUNKWRITER_H
+#define HDF5PP_CHUNKWRITER_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class ChunkWriter.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <algorithm>
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/DataSet.h"
+#include "hdf5pp/Type.h"
+#include "ndarray/ndarray.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Parallel compression pipeline for chunked datasets.
+ *
+ *  Incoming data are split into chunks matching dataset chunk dimensions,
+ *  chunks are compressed by a pool of worker threads (see FilterPipeline)
+ *  and compressed chunks are written with DataSet::writeChunk() in the same
+ *  order as they were produced. All HDF5 calls are made from the thread which
+ *  calls methods of this class, worker threads never call HDF5. Files produced
+ *  this way are identical to files written through H5Dwrite() and can be read
+ *  by any HDF5 tool.
+ *
+ *  Data are written without type conversion, so in-memory type must be the same
+ *  as dataset type, and dataset can only have filters supported by FilterPipeline.
+ *
+ *  Two modes of operation are supported: append() adds records to the end of
+ *  rank-1 extensible dataset, write() stores rank-N array at chunk-aligned
+ *  position inside current dataset extent. Chunks which are only partially
+ *  covered by data written with write() are padded with zeros.
+ *
+ *  Writer objects have reference semantics, copies share the same state.
+ *  Pending data are written by flush() or when the last copy is destroyed.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see FilterPipeline
+ *
+ *  @version $Id$
+ */
+
+class ChunkWriter  {
+public:
+
+  // Default constructor, makes non-valid writer
+  ChunkWriter() {}
+
+  /**
+   *  @brief Make writer for a dataset.
+   *
+   *  @param[in] ds          Chunked dataset.
+   *  @param[in] native_type In-memory type of data, must be equal to dataset type.
+   *  @param[in] nThreads    Number of compression threads, 0 means number of CPU cores.
+   *  @param[in] maxPending  Max. number of chunks in flight, 0 means four per thread.
+   *                         When this limit is reached caller is blocked until oldest
+   *                         chunk is compressed and written.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  ChunkWriter(const DataSet& ds, const Type& native_type, unsigned nThreads = 0, unsigned maxPending = 0);
+
+  // Destructor
+  ~ChunkWriter() ;
+
+  /**
+   *  @brief Append records to the end of rank-1 dataset.
+   *
+   *  Records are copied, complete chunks are sent for compression immediately,
+   *  last incomplete chunk is kept until it is filled or flushed.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void append(const void* data, hsize_t count);
+
+  /**
+   *  @brief Write rank-N array into a dataset.
+   *
+   *  @param[in] data    Array data in C order.
+   *  @param[in] dims    Array dimensions, same rank as dataset.
+   *  @param[in] offset  Position of array in dataset, must be aligned on chunk boundaries,
+   *                     zero pointer means origin.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void write(const void* data, const hsize_t dims[], const hsize_t offset[] = 0);
+
+  /// Write ndarray into a dataset, see write(const void*, const hsize_t[], const hsize_t[]).
+  template <typename T, unsigned Rank>
+  void write(const ndarray<T, Rank>& array, const hsize_t offset[] = 0) {
+    hsize_t dims[Rank];
+    std::copy(array.shape(), array.shape()+Rank, dims);
+    write(static_cast<const void*>(array.data()), dims, offset);
+  }
+
+  /**
+   *  @brief Wait until all pending chunks are compressed and written.
+   *
+   *  Incomplete last chunk of rank-1 dataset is written too, padded with zeros.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void flush();
+
+  /// Get dataset object
+  DataSet dataSet() const;
+
+  // returns true if there is a real object behind
+  bool valid() const { return m_impl.get(); }
+
+protected:
+
+private:
+
+  struct Impl;
+
+  // Data members
+  boost::shared_ptr<Impl> m_impl;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_CHUNKWRITER_H
@@ -0,0 +1,135 @@
+#ifndef HDF5PP_COLUMNS_H
+#define HDF5PP_COLUMNS_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class Columns.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/Type.h"
+#include "hdf5pp/TypeTraits.h"
+#include "ndarray/ndarray.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief List of columns for Utils::readColumns().
+ *
+ *  Each column binds a member of compound dataset type to a rank-1 ndarray
+ *  which receives values of that member. Arrays are (re-)allocated by
+ *  Utils::readColumns() to the number of records read. Example:
+ *
+ *  @code
+ *  ndarray<int32_t, 1> id;
+ *  ndarray<double, 1> energy;
+ *  hdf5pp::Columns columns;
+ *  columns.add("id", id).add("energy", energy);
+ *  hdf5pp::Utils::readColumns(ds, columns);
+ *  @endcode
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see Utils::readColumns
+ *
+ *  @version $Id$
+ */
+
+class Columns  {
+public:
+
+  // Default constructor
+  Columns() {}
+
+  /**
+   *  @brief Add a column.
+   *
+   *  Array object must stay alive until the columns are read.
+   *
+   *  @param[in]  member       Name of compound member.
+   *  @param[out] array        Array which receives member values.
+   *  @param[in]  native_type  In-memory type of member values.
+   */
+  template <typename T>
+  Columns& add(const std::string& member, ndarray<T, 1>& array,
+      const Type& native_type = TypeTraits<T>::native_type())
+  {
+    m_columns.push_back(boost::shared_ptr<ColumnBase>(new Column<T>(member, native_type, array)));
+    return *this;
+  }
+
+  /// Get number of columns
+  size_t size() const { return m_columns.size(); }
+
+  /// Get member name for a column
+  const std::string& member(size_t i) const { return m_columns[i]->member; }
+
+  /// Get in-memory type for a column
+  const Type& type(size_t i) const { return m_columns[i]->type; }
+
+  /// Allocate array for a column, returns pointer to array data
+  void* allocate(size_t i, hsize_t count) { return m_columns[i]->allocate(count); }
+
+protected:
+
+private:
+
+  struct ColumnBase {
+    ColumnBase(const std::string& member, const Type& type) : member(member), type(type) {}
+    virtual ~ColumnBase() {}
+    virtual void* allocate(hsize_t count) = 0;
+    std::string member;
+    Type type;
+  };
+
+  template <typename T>
+  struct Column : public ColumnBase {
+    Column(const std::string& member, const Type& type, ndarray<T, 1>& array)
+      : ColumnBase(member, type), array(array) {}
+    virtual void* allocate(hsize_t count) {
+      unsigned shape[] = { unsigned(count) };
+      array = ndarray<T, 1>(shape);
+      return array.data();
+    }
+    ndarray<T, 1>& array;
+  };
+
+  // Data members
+  std::vector<boost::shared_ptr<ColumnBase> > m_columns;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_COLUMNS_H
@@ -0,0 +1,158 @@
+#ifndef HDF5PP_COMPOUNDTRAITS_H
+#define HDF5PP_COMPOUNDTRAITS_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Macro HDF5PP_COMPOUND and class CompoundTraitsHelper.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <cstddef>
+#include <vector>
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/stringize.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/Type.h"
+#include "hdf5pp/TypeCache.h"
+#include "hdf5pp/TypeTraits.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Type of a compound member, arrays become HDF5 array types.
+ */
+template <typename M>
+struct CompoundMemberTraits {
+  static Type native_type() { return TypeTraits<M>::native_type(); }
+  static Type stored_type() { return TypeTraits<M>::stored_type(); }
+};
+
+template <typename M, std::size_t N>
+struct CompoundMemberTraits<M[N]> {
+  static Type native_type() { return TypeCache::arrayType(CompoundMemberTraits<M>::native_type(), N); }
+  static Type stored_type() { return TypeCache::arrayType(CompoundMemberTraits<M>::stored_type(), N); }
+};
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Helper class for the types generated by HDF5PP_COMPOUND macro.
+ *
+ *  Builds native type with the same layout as C++ structure and stored type
+ *  with the same members packed without padding. Both types are locked and
+ *  live until the end of the process.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see HDF5PP_COMPOUND
+ *
+ *  @version $Id$
+ */
+
+struct CompoundTraitsHelper {
+
+  /// Description of one structure member
+  struct Member {
+    const char* name;   ///< Member name
+    size_t offset;      ///< Offset in C++ structure
+    Type native;        ///< In-memory type
+    Type stored;        ///< Type in file
+  };
+
+  typedef std::vector<Member> Members;
+
+  /// Make member description, member type is deduced from pointer to member.
+  template <typename C, typename M>
+  static Member member(const char* name, size_t offset, M C::*) {
+    Member m = { name, offset, CompoundMemberTraits<M>::native_type(), CompoundMemberTraits<M>::stored_type() };
+    return m;
+  }
+
+  /**
+   *  @brief Build native type for a structure of given size.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type native_type(size_t size, const Members& members);
+
+  /**
+   *  @brief Build packed stored type.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type stored_type(const Members& members);
+
+};
+
+} // namespace hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Define TypeTraits for a C++ structure.
+ *
+ *  Member offsets and member types are derived from structure definition, type
+ *  of each member must have TypeTraits defined (or be a fixed-size array of
+ *  such type). Native type has the same layout as the structure, stored type
+ *  has the same members without padding between them. Both types are built
+ *  once on first use. Macro must be used at global namespace scope with fully
+ *  qualified structure name, e.g.:
+ *
+ *  @code
+ *  namespace ns { struct Record { int32_t id; double pos[3]; uint8_t flag; }; }
+ *  HDF5PP_COMPOUND(ns::Record, (id)(pos)(flag))
+ *  @endcode
+ */
+#define HDF5PP_COMPOUND(CPP_TYPE, FIELDS) \
+  namespace hdf5pp { \
+  template <> struct TypeTraits<CPP_TYPE> { \
+    static Type stored_type(size_t size=0) { \
+      static const Type type = CompoundTraitsHelper::stored_type(members()); \
+      return TypeTraitsHelper::sized_h5type(type, size); \
+    } \
+    static Type native_type(size_t size=0) { \
+      static const Type type = CompoundTraitsHelper::native_type(sizeof(CPP_TYPE), members()); \
+      return TypeTraitsHelper::sized_h5type(type, size); \
+    } \
+    static const void* address( const CPP_TYPE& value ) { return static_cast<const void*>(&value) ; } \
+    static void* address( CPP_TYPE& value ) { return static_cast<void*>(&value) ; } \
+  private: \
+    static CompoundTraitsHelper::Members members() { \
+      CompoundTraitsHelper::Members members; \
+      BOOST_PP_SEQ_FOR_EACH(HDF5PP_COMPOUND_MEMBER_, CPP_TYPE, FIELDS) \
+      return members; \
+    } \
+  }; \
+  }
+
+#define HDF5PP_COMPOUND_MEMBER_(r, CPP_TYPE, FIELD) \
+  members.push_back(CompoundTraitsHelper::member(BOOST_PP_STRINGIZE(FIELD), offsetof(CPP_TYPE, FIELD), &CPP_TYPE::FIELD));
+
+#endif // HDF5PP_COMPOUNDTRAITS_H
@@ -0,0 +1,87 @@
+#ifndef HDF5PP_CONVERSIONS_H
+#define HDF5PP_CONVERSIONS_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class Conversions.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Fast data conversion functions for HDF5 library.
+ *
+ *  HDF5 converts between byte orders and between most numeric types with
+ *  element-by-element loops. This class registers with H5Tregister() hard
+ *  conversion functions which convert data in blocks with simple loops that
+ *  compiler can vectorize. Registered conversions are:
+ *  - byte swapping between native and opposite byte order for 16, 32 and
+ *    64-bit integers and for float and double types;
+ *  - int16 to float, uint16 to int32 and double to float, with source in
+ *    either native or opposite byte order.
+ *
+ *  Conversions are registered by init(), after that they are used by all
+ *  reads and writes in a process. Double to float conversion does not call
+ *  conversion exception callback (H5Pset_type_conv_cb), values outside of
+ *  float range become infinities.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @version $Id$
+ */
+
+class Conversions  {
+public:
+
+  /**
+   *  @brief Register conversion functions.
+   *
+   *  Only the first call registers functions, following calls do nothing.
+   *  Returns number of registered conversion paths.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static unsigned init();
+
+protected:
+
+private:
+
+  // This class is not supposed to be instantiated
+  Conversions();
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_CONVERSIONS_H
@@ -13,6 +13,10 @@
 //-----------------
 // C/C++ Headers --
 //-----------------
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
 
 //----------------------
 // Base Class Headers --
@@ -25,8 +29,11 @@
 #include "hdf5pp/DataSpace.h"
 #include "hdf5pp/PListDataSetAccess.h"
 #include "hdf5pp/PListDataSetCreate.h"
+#include "hdf5pp/PListDataSetXfer.h"
 #include "hdf5pp/Type.h"
+#include "hdf5pp/TypeCache.h"
 #include "hdf5pp/TypeTraits.h"
+#include "ndarray/ndarray.h"
 
 //------------------------------------
 // Collaborating Class Declarations --
@@ -58,6 +65,13 @@ class Group ;
 class DataSet {
 public:
 
+  /// Action taken when read or write needs data type conversion
+  enum ConversionCheck {
+    ConversionAllow,   ///< Convert silently
+    ConversionWarn,    ///< Log a warning when a new in-memory type needs conversion
+    ConversionThrow    ///< Throw Hdf5TypeConversion exception
+  };
+
   // Default constructor
   DataSet() {}
 
@@ -82,6 +96,38 @@ public:
   /// same operation for rank-1 data set
   void set_extent ( hsize_t size ) { set_extent(&size); }
 
+  /**
+   *  @brief Enable extent reservation for rank-1 extensible dataset.
+   *
+   *  By default resize() changes dataset extent to exactly the requested size.
+   *  With reservation enabled physical extent grows in bigger steps, each step is
+   *  a multiple of chunk size and at least (growth-1) times current extent but
+   *  not more than maxStep elements (if maxStep is non-zero). Logical size is
+   *  tracked separately and is saved in the "_hdf5pp_size" attribute when
+   *  physical extent grows, by flush() and when the last handle is closed,
+   *  size() of the handles opened independently (or by other processes)
+   *  returns the value of this attribute. Between updates attribute may be
+   *  smaller than logical size, it never covers unwritten data. Physical
+   *  extent is trimmed to logical size by flush() and when the last handle
+   *  for the dataset is closed.
+   *
+   *  @param[in] growth   Growth factor, 1 means growing by one chunk at a time.
+   *  @param[in] maxStep  Upper limit on growth step in elements, 0 means no limit.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void set_reserve(double growth = 2.0, hsize_t maxStep = 0);
+
+  /// Get size of rank-1 dataset, this is logical size if dataset has "_hdf5pp_size" attribute.
+  hsize_t size();
+
+  /// Change size of rank-1 dataset, with reservation enabled this may reserve more space.
+  void resize(hsize_t size);
+
+  /// Trim reserved extent to logical size and store logical size in attribute,
+  /// does nothing if reservation is not enabled.
+  void flush();
+
   // store the data
   template <typename T>
   void store ( const DataSpace& memDspc,
@@ -120,6 +166,42 @@ public:
     _read(native_type, memDspc, fileDspc, TypeTraits<T>::address(*data));
   }
 
+  // retrieve the data from dataset, give transfer property list
+  template <typename T>
+  void read (const DataSpace& memDspc,
+             const DataSpace& fileDspc,
+             T* data,
+             const hdf5pp::Type& native_type,
+             const PListDataSetXfer& plistXfer)
+  {
+    _read(native_type, memDspc, fileDspc, TypeTraits<T>::address(*data), plistXfer.plist());
+  }
+
+  /**
+   *  @brief Read selected members of compound data.
+   *
+   *  Only listed members of in-memory compound type are read and converted,
+   *  other members of the objects in memory are not changed. Subset type is
+   *  built once for each combination of type and member list.
+   *
+   *  @param[in]  fields       Names of compound members to read.
+   *  @param[in]  memDspc      Memory dataspace.
+   *  @param[in]  fileDspc     File dataspace (selection).
+   *  @param[out] data         Objects to fill.
+   *  @param[in]  native_type  Compound in-memory type of the objects.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename T>
+  void readFields(const std::vector<std::string>& fields,
+                  const DataSpace& memDspc,
+                  const DataSpace& fileDspc,
+                  T* data,
+                  const hdf5pp::Type& native_type = TypeTraits<T>::native_type())
+  {
+    _read(TypeCache::subsetType(native_type, fields), memDspc, fileDspc, TypeTraits<T>::address(*data));
+  }
+
   // reclaim space allocated to vlen structures
   template <typename T>
   void vlen_reclaim(const DataSpace& memDspc,
@@ -138,6 +220,104 @@ public:
   /// get chunk size, this method only works for 1-dim datasets
   size_t chunkSize() const;
 
+  /// get chunk dimensions, size of dims array must be at least rank of the dataset,
+  /// returns chunk rank
+  unsigned chunkDims(hsize_t dims[]) const;
+
+  /**
+   *  @brief Write raw chunk data bypassing HDF5 filter pipeline.
+   *
+   *  Data must be already processed by the filters defined for the dataset, e.g.
+   *  with FilterPipeline::encode(). Chunk must be fully within the current dataset
+   *  extent, dataset extent is not changed by this method.
+   *
+   *  @param[in] offset      Logical position of the chunk first element in a dataset,
+   *                         must be aligned on chunk boundary.
+   *  @param[in] filterMask  Mask of filters that were skipped, bit N set means that
+   *                         filter number N in a pipeline was not applied.
+   *  @param[in] data        Chunk data
+   *  @param[in] size        Chunk data size in bytes
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void writeChunk(const hsize_t offset[], uint32_t filterMask, const void* data, size_t size);
+
+  /**
+   *  @brief Read raw chunk data bypassing HDF5 filter pipeline.
+   *
+   *  Data are returned as stored in a file, e.g. compressed, use FilterPipeline::decode()
+   *  to undo filters. Chunks written through this handle may stay in the chunk cache,
+   *  dataset has to be flushed with H5Dflush() before reading them this way.
+   *
+   *  @param[in]  offset      Logical position of the chunk first element in a dataset,
+   *                          must be aligned on chunk boundary.
+   *  @param[out] filterMask  Mask of filters that were skipped when chunk was written.
+   *  @param[out] data        Chunk data, will be resized.
+   *  @return     False if chunk has no storage allocated (data is empty then), true otherwise.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  bool readChunk(const hsize_t offset[], uint32_t& filterMask, std::vector<char>& data);
+
+  /**
+   *  @brief Check whether dataset can be memory-mapped with mapView().
+   *
+   *  This is true for datasets with allocated contiguous storage in a file
+   *  using default (sec2) driver, without filters or external storage, and
+   *  with the type equal to the given in-memory type.
+   */
+  bool mappable(const Type& native_type);
+
+  /**
+   *  @brief Return read-only view of the dataset data mapped directly from file.
+   *
+   *  Dataset data are mapped into memory with mmap(), no data are read until
+   *  array elements are accessed. Mapping is released when the last copy of
+   *  returned array is destroyed. If file is open for writing it is flushed
+   *  first, data written after the mapping was made may not be visible in it.
+   *  Array rank must be the same as dataset rank.
+   *
+   *  @throw hdf5pp::Exception if dataset is not mappable()
+   */
+  template <typename T, unsigned Rank>
+  ndarray<const T, Rank> mapView(const hdf5pp::Type& native_type = TypeTraits<T>::native_type())
+  {
+    hsize_t dims[Rank];
+    boost::shared_ptr<const void> map = _mapView(native_type, Rank, dims);
+    unsigned shape[Rank];
+    std::copy(dims, dims+Rank, shape);
+    boost::shared_ptr<const T> data(map, static_cast<const T*>(map.get()));
+    return ndarray<const T, Rank>(data, shape);
+  }
+
+  /**
+   *  @brief Check whether reading or writing with given in-memory type needs no conversion.
+   *
+   *  Returns true if in-memory type is identical to the dataset type, in this case
+   *  HDF5 copies data without conversion. Any difference, e.g. in byte order,
+   *  member offsets or padding of compound types, makes HDF5 convert every
+   *  element. Types containing variable-length data are always converted.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  bool noopConversion(const Type& native_type);
+
+  /// Get number of bytes converted by reads and writes through this handle and its copies
+  uint64_t convertedBytes() const;
+
+  /// Get number of reads and writes through this handle and its copies that needed conversion
+  unsigned long conversions() const;
+
+  /**
+   *  @brief Set action taken for reads and writes that need data type conversion.
+   *
+   *  Setting is global for all datasets, by default conversion is allowed.
+   */
+  static void setConversionCheck(ConversionCheck check);
+
+  /// Get action taken for reads and writes that need data type conversion
+  static ConversionCheck conversionCheck();
+
   /// access dataset type
   Type type();
 
@@ -153,6 +333,8 @@ public:
 protected:
 
   friend class Group ;
+  friend class DataSetCache ;
+  friend class RowAppender ;
 
   // Constructor
   DataSet(hid_t id);
@@ -182,12 +364,33 @@ private:
   void _read(const Type& memType,
              const DataSpace& memDspc,
              const DataSpace& fileDspc,
-             void* data);
+             void* data,
+             hid_t plistXfer = H5P_DEFAULT);
 
   void _vlen_reclaim(const hdf5pp::Type& type, const DataSpace& memDspc, void* data);
 
+  // check conversion before read or write, update counters
+  void _checkConversion(const Type& memType, const DataSpace& memDspc, const DataSpace& fileDspc);
+
+  // true if handle must stay open: it is used by other copies or has extent reservation
+  bool _pinned() const;
+
+  // map dataset data into memory, returns dimensions in dims
+  boost::shared_ptr<const void> _mapView(const Type& native_type, unsigned rank, hsize_t dims[]);
+
+  // extent reservation state shared by all copies
+  struct Extent;
+
+  // deleter for dataset id, trims reserved extent before closing
+  struct IdDeleter;
+
+  // type conversion state shared by all copies
+  struct Conversion;
+
   // Data members
+  boost::shared_ptr<Extent> m_extent ;
   boost::shared_ptr<hid_t> m_id ;
+  boost::shared_ptr<Conversion> m_conv ;
 
 };
 
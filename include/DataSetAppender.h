@@ -0,0 +1,168 @@
+#ifndef HDF5PP_DATASETAPPENDER_H
+#define HDF5PP_DATASETAPPENDER_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class DataSetAppender.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/DataSet.h"
+#include "hdf5pp/Type.h"
+#include "hdf5pp/TypeTraits.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Buffered appender of records to rank-1 extensible dataset.
+ *
+ *  Instead of extending dataset by one element and writing single record
+ *  for every call (which is what Utils::storeAt() does) this class collects
+ *  records in a memory buffer and writes whole buffer with one extent change
+ *  and one hyperslab write. Default buffer size is equal to the dataset chunk
+ *  size, first buffer is shortened so that all subsequent writes are aligned
+ *  on chunk boundaries.
+ *
+ *  Appender objects have reference semantics, copies share the same buffer.
+ *  Buffered data are written when flush() is called or when the last copy of
+ *  the appender is destroyed. Records are copied into buffer as plain memory,
+ *  for types which contain pointers (VLEN data, variable-length strings) the
+ *  pointed-to data must stay alive until buffer is flushed.
+ *
+ *  Dataset must be rank-1 extensible dataset, e.g. one created with
+ *  Utils::createDataset(). While appender exists nobody else should change
+ *  size of the dataset.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see Utils::createDataset
+ *
+ *  @version $Id$
+ */
+
+class DataSetAppender  {
+public:
+
+  // Default constructor, makes non-valid appender
+  DataSetAppender() {}
+
+  /**
+   *  @brief Make appender for a dataset.
+   *
+   *  @param[in] ds          Rank-1 extensible dataset.
+   *  @param[in] native_type In-memory type of the records.
+   *  @param[in] bufSize     Buffer size in records, if zero then dataset chunk size is used.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  DataSetAppender(const DataSet& ds, const Type& native_type, hsize_t bufSize = 0);
+
+  // Destructor
+  ~DataSetAppender() ;
+
+  /**
+   *  @brief Add one record to the end of dataset.
+   *
+   *  Data pointer must point to an object of the type which was given to constructor.
+   *  If buffer becomes full it is flushed to a dataset.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void append(const void* data);
+
+  /**
+   *  @brief Write all buffered records to a dataset.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void flush();
+
+  /// Get dataset size including records which are still in buffer
+  hsize_t size() const;
+
+  /// Get number of records in buffer which have not been written yet
+  hsize_t buffered() const;
+
+  /// Get dataset object
+  DataSet dataSet() const;
+
+  // returns true if there is a real object behind
+  bool valid() const { return m_impl.get(); }
+
+protected:
+
+private:
+
+  struct Impl;
+
+  // Data members
+  boost::shared_ptr<Impl> m_impl;
+
+};
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Typed version of DataSetAppender.
+ *
+ *  In-memory type of the records is determined from TypeTraits<T>::native_type()
+ *  unless explicit type is given.
+ */
+
+template <typename T>
+class Appender : public DataSetAppender {
+public:
+
+  // Default constructor, makes non-valid appender
+  Appender() {}
+
+  /**
+   *  @brief Make appender for a dataset.
+   *
+   *  @param[in] ds          Rank-1 extensible dataset.
+   *  @param[in] bufSize     Buffer size in records, if zero then dataset chunk size is used.
+   *  @param[in] native_type In-memory type of the records.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  explicit Appender(const DataSet& ds, hsize_t bufSize = 0,
+      const Type& native_type = TypeTraits<T>::native_type())
+    : DataSetAppender(ds, native_type, bufSize) {}
+
+  /// Add one record to the end of dataset.
+  void append(const T& data) { DataSetAppender::append(TypeTraits<T>::address(data)); }
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_DATASETAPPENDER_H
@@ -0,0 +1,151 @@
+#ifndef HDF5PP_DATASETCACHE_H
+#define HDF5PP_DATASETCACHE_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class DataSetCache.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <list>
+#include <map>
+#include <string>
+#include <boost/thread/mutex.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/DataSet.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Bounded LRU cache of open dataset handles.
+ *
+ *  Every file has one cache which is shared by all groups opened from that
+ *  file, datasets opened or created through Group are kept in it so that
+ *  repeated Group::openDataSet() calls return the same handle and its
+ *  shared state (extent reservation, conversion counters). Cache keeps at
+ *  most capacity() handles, least recently used datasets are closed when
+ *  this budget is exceeded and are transparently reopened by the next
+ *  Group::openDataSet().
+ *
+ *  Datasets which are pinned are never evicted: handles which are still
+ *  used outside of the cache (e.g. by appenders or readers holding buffered
+ *  data) and datasets with extent reservation enabled. If all datasets are
+ *  pinned the cache can temporarily grow above its capacity.
+ *
+ *  Cache is keyed by absolute dataset path. All methods are thread-safe.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see Group
+ *
+ *  @version $Id$
+ */
+
+class DataSetCache  {
+public:
+
+  /// Make cache with given capacity, zero means default capacity.
+  explicit DataSetCache(size_t capacity = 0);
+
+  // Destructor
+  ~DataSetCache() ;
+
+  /**
+   *  @brief Find dataset in cache.
+   *
+   *  Returns non-valid dataset object if dataset is not in the cache,
+   *  dataset which is found becomes most recently used.
+   */
+  DataSet find(const std::string& path);
+
+  /// Check whether dataset is in cache, does not change LRU order or statistics.
+  bool contains(const std::string& path) const;
+
+  /// Add dataset to the cache, least recently used datasets may be evicted.
+  void insert(const std::string& path, const DataSet& ds);
+
+  /// Remove dataset from the cache.
+  void erase(const std::string& path);
+
+  /// Remove all datasets from the cache.
+  void clear();
+
+  /// Get maximum number of open handles.
+  size_t capacity() const;
+
+  /// Change maximum number of open handles, evicts datasets if necessary.
+  void setCapacity(size_t capacity);
+
+  /// Get number of datasets in cache.
+  size_t size() const;
+
+  /// Get number of lookups which found dataset in cache.
+  unsigned long hits() const;
+
+  /// Get number of lookups which did not find dataset in cache.
+  unsigned long misses() const;
+
+  /// Get number of datasets evicted from cache.
+  unsigned long evictions() const;
+
+  /// Set capacity of caches made for files opened after this call.
+  static void setDefaultCapacity(size_t capacity);
+
+  /// Get capacity of caches made for new files.
+  static size_t defaultCapacity();
+
+protected:
+
+private:
+
+  typedef std::list<std::pair<std::string, DataSet> > LruList;
+  typedef std::map<std::string, LruList::iterator> Index;
+
+  // Copy constructor and assignment are disabled by default
+  DataSetCache ( const DataSetCache& ) ;
+  DataSetCache& operator = ( const DataSetCache& ) ;
+
+  // evict least recently used datasets which are not pinned, must be called with mutex held
+  void _evict();
+
+  // Data members
+  mutable boost::mutex m_mutex;   ///< Protects all members
+  size_t m_capacity;              ///< Max number of open handles
+  LruList m_lru;                  ///< Datasets, most recently used first
+  Index m_index;                  ///< Path to position in LRU list
+  size_t m_scanAt;                ///< Cache size at which eviction is tried again
+  unsigned long m_hits;           ///< Number of lookups found in cache
+  unsigned long m_misses;         ///< Number of lookups not found in cache
+  unsigned long m_evictions;      ///< Number of evicted datasets
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_DATASETCACHE_H
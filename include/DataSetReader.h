@@ -0,0 +1,173 @@
+#ifndef HDF5PP_DATASETREADER_H
+#define HDF5PP_DATASETREADER_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class DataSetReader.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/DataSet.h"
+#include "hdf5pp/Type.h"
+#include "hdf5pp/TypeTraits.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Reader of individual records from rank-1 dataset with read-ahead.
+ *
+ *  Reading records one by one with Utils::readDataSet(ds, index) makes one
+ *  H5Dread() call per record. This class detects sequential access and reads
+ *  a whole window of records (by default one chunk, aligned on chunk boundary)
+ *  with a single H5Dread(), following records are then served from memory.
+ *  Random access reads only the requested record. Two windows are kept, when
+ *  background prefetch is enabled the next window is read by a separate thread
+ *  while records from the current window are consumed. Background prefetch
+ *  is only used if HDF5 library is thread-safe, otherwise it is disabled.
+ *
+ *  Reader objects have reference semantics, copies share the same state.
+ *  Reader is not thread-safe itself, one reader should only be used by one
+ *  thread.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see Utils::readDataSet
+ *
+ *  @version $Id$
+ */
+
+class DataSetReader  {
+public:
+
+  // Default constructor, makes non-valid reader
+  DataSetReader() {}
+
+  /**
+   *  @brief Make reader for a dataset.
+   *
+   *  @param[in] ds          Rank-1 dataset.
+   *  @param[in] native_type In-memory type of the records.
+   *  @param[in] window      Read-ahead window size in records, if zero then dataset
+   *                         chunk size is used (or 1024 for non-chunked datasets).
+   *  @param[in] background  If true then next window is prefetched in a separate thread.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  DataSetReader(const DataSet& ds, const Type& native_type, hsize_t window = 0, bool background = false);
+
+  // Destructor
+  ~DataSetReader() ;
+
+  /**
+   *  @brief Get pointer to a record.
+   *
+   *  Returned pointer stays valid until the next call to any method of this
+   *  reader. For records containing VLEN data the memory they point to is also
+   *  released when the window is replaced.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  const void* get(hsize_t index);
+
+  /**
+   *  @brief Copy one record to a caller-provided location.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void read(hsize_t index, void* data);
+
+  /// Get number of records in a dataset
+  hsize_t size() const;
+
+  /// Get number of H5Dread() calls made so far
+  unsigned long reads() const;
+
+  /// Get dataset object
+  DataSet dataSet() const;
+
+  // returns true if there is a real object behind
+  bool valid() const { return m_impl.get(); }
+
+protected:
+
+private:
+
+  struct Impl;
+
+  // Data members
+  boost::shared_ptr<Impl> m_impl;
+
+};
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Typed version of DataSetReader.
+ *
+ *  In-memory type of the records is determined from TypeTraits<T>::native_type()
+ *  unless explicit type is given.
+ */
+
+template <typename T>
+class Reader : public DataSetReader {
+public:
+
+  // Default constructor, makes non-valid reader
+  Reader() {}
+
+  /**
+   *  @brief Make reader for a dataset.
+   *
+   *  @param[in] ds          Rank-1 dataset.
+   *  @param[in] window      Read-ahead window size in records, if zero then dataset chunk size is used.
+   *  @param[in] background  If true then next window is prefetched in a separate thread.
+   *  @param[in] native_type In-memory type of the records.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  explicit Reader(const DataSet& ds, hsize_t window = 0, bool background = false,
+      const Type& native_type = TypeTraits<T>::native_type())
+    : DataSetReader(ds, native_type, window, background) {}
+
+  using DataSetReader::read;
+
+  /// Get reference to a record, valid until the next call to any method of this reader.
+  const T& at(hsize_t index) { return *static_cast<const T*>(DataSetReader::get(index)); }
+
+  /// Return copy of a record.
+  T read(hsize_t index) { return at(index); }
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_DATASETREADER_H
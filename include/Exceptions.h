@@ -103,6 +103,13 @@ public:
 
 };
 
+class Hdf5TypeConversion : public Exception {
+public:
+
+  Hdf5TypeConversion( const ErrSvc::Context& ctx, const std::string& dataset )
+    : Exception( ctx, "Hdf5TypeConversion", "In-memory type needs conversion for dataset " + dataset ) {}
+
+};
 
 } // namespace hdf5pp
 
@@ -24,7 +24,10 @@
 // Collaborating Class Headers --
 //-------------------------------
 #include "hdf5/hdf5.h"
+#include "hdf5pp/Catalog.h"
+#include "hdf5pp/DataSetCache.h"
 #include "hdf5pp/Group.h"
+#include "hdf5pp/PathCache.h"
 #include "hdf5pp/Attribute.h"
 #include "hdf5pp/DataSpace.h"
 #include "hdf5pp/PListFileAccess.h"
@@ -70,7 +73,8 @@ public:
                         const PListFileCreate& plCreate = PListFileCreate(),
                         const PListFileAccess& plAccess = PListFileAccess() ) ;
   /**
-   *  open existing HDF5 file.
+   *  open existing HDF5 file. Files opened for reading which have a valid
+   *  sidecar index (see FileIndex) load it, see catalog().
    */
   static File open( const std::string& path,
                      OpenMode mode,
@@ -85,13 +89,13 @@ public:
   /// Create new group, group name treated as relative to the file
   /// (i.e. absolute).
   Group createGroup ( const std::string& name ) {
-    return Group::createGroup ( *m_id, name ) ;
+    return Group::createGroup ( *m_id, _path(name), m_dsCache, m_pathCache ) ;
   }
 
   /// Open existing group, group name treated as relative to the file
   /// (i.e. absolute).
   Group openGroup ( const std::string& name ) {
-    return Group::openGroup ( *m_id, name ) ;
+    return Group::openGroup ( *m_id, _path(name), m_dsCache, m_pathCache ) ;
   }
 
   /// create attribute for this file
@@ -106,14 +110,37 @@ public:
     return Attribute<T>::openAttr ( *m_id, name ) ;
   }
 
-  // close the file
+  /**
+   *  @brief Get cache of open datasets.
+   *
+   *  All groups opened from this file share one cache of open dataset handles,
+   *  its capacity is the budget of open dataset handles for this file.
+   */
+  DataSetCache& dataSetCache() const { return *m_dsCache; }
+
+  /**
+   *  @brief Get cache of resolved paths.
+   *
+   *  All groups opened from this file share one path cache.
+   */
+  PathCache& pathCache() const { return *m_pathCache; }
+
+  /**
+   *  @brief Get catalog of the file objects.
+   *
+   *  Catalog is only available for files opened for reading which have a
+   *  valid sidecar index (see FileIndex), otherwise catalog is empty.
+   */
+  const Catalog& catalog() const { return m_catalog; }
+
+  // close the file, datasets in the cache are released
   void close() ;
 
   // returns true if there is a real object behind
   bool valid() const { return m_id.get() ; }
 
   // returns file id if valid object, otherwise -1
-  hid_t id() { return valid() ? *m_id : -1; }
+  hid_t id() const { return valid() ? *m_id : -1; }
 
 protected:
 
@@ -124,8 +151,14 @@ protected:
 
 private:
 
+  // absolute path for a name
+  static std::string _path(const std::string& name) { return Group::_normalize("/" + name); }
+
   // Data members
   boost::shared_ptr<hid_t> m_id ;
+  boost::shared_ptr<DataSetCache> m_dsCache ;
+  boost::shared_ptr<PathCache> m_pathCache ;
+  Catalog m_catalog ;
 
 };
 
@@ -0,0 +1,100 @@
+#ifndef HDF5PP_FILEINDEX_H
+#define HDF5PP_FILEINDEX_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class FileIndex.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <string>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Catalog.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Persistent sidecar index of HDF5 file.
+ *
+ *  Index is a Catalog of the file saved next to it in a file with ".idx"
+ *  suffix, together with file size and modification time at the moment of
+ *  scanning. Index is only used while size and modification time of the
+ *  file stay the same. Index is optional and has to be made explicitly with
+ *  create() after the file is closed by writer.
+ *
+ *  When file is opened for reading with File::open() and it has a valid
+ *  index, the catalog is available from File::catalog() and the file path
+ *  cache looks up paths in it, so that groups are opened by their tokens and
+ *  Group::hasChild() is answered without traversing group B-trees. Index is
+ *  not stored in the HDF5 file itself because writing it would change the
+ *  file modification time which is used for validation.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see Catalog, PathCache
+ *
+ *  @version $Id$
+ */
+
+class FileIndex  {
+public:
+
+  /// Get name of the index file for HDF5 file
+  static std::string indexPath(const std::string& path) { return path + ".idx"; }
+
+  /**
+   *  @brief Scan file and write its index.
+   *
+   *  Index is written to a temporary file which is then renamed, so readers
+   *  never see partially written index.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Catalog create(const std::string& path);
+
+  /**
+   *  @brief Read index of a file.
+   *
+   *  Returns false and empty catalog if index does not exist, does not match
+   *  the file or fails validation in Catalog::read().
+   */
+  static bool read(const std::string& path, Catalog& catalog);
+
+protected:
+
+private:
+
+  // This class is not supposed to be instantiated
+  FileIndex();
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_FILEINDEX_H
@@ -0,0 +1,127 @@
+#ifndef HDF5PP_FILTERPIPELINE_H
+#define HDF5PP_FILTERPIPELINE_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class FilterPipeline.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <vector>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/DataSet.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Software implementation of the dataset filter pipeline.
+ *
+ *  This class reads the list of filters from dataset creation property list
+ *  and applies the same transformations to chunk data as HDF5 library does
+ *  inside H5Dwrite(). Result can be passed to DataSet::writeChunk(), which
+ *  means that compression can be done outside HDF5 library (and in any
+ *  thread, methods encode() and decode() do not call HDF5). Method decode()
+ *  does the reverse transformation for chunks from DataSet::readChunk().
+ *  Only shuffle and deflate filters are supported, pipeline with any other
+ *  filter is not supported() and its encode() and decode() methods throw.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see DataSet::writeChunk
+ *
+ *  @version $Id$
+ */
+
+class FilterPipeline  {
+public:
+
+  // Default constructor, makes empty pipeline
+  FilterPipeline() {}
+
+  /**
+   *  @brief Make pipeline from dataset filters.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  explicit FilterPipeline(const DataSet& ds);
+
+  /// Returns true if all filters in the pipeline are supported
+  bool supported() const;
+
+  /// Returns true if pipeline has no filters
+  bool empty() const { return m_filters.empty(); }
+
+  /**
+   *  @brief Apply filters to chunk data.
+   *
+   *  Optional filters which fail (e.g. when compressed data is larger than input)
+   *  are skipped and their bits are set in returned filter mask.
+   *
+   *  @param[in]  data   Chunk data, complete chunk in memory layout of the file type.
+   *  @param[in]  size   Size of chunk data in bytes.
+   *  @param[out] out    Buffer for filtered data, will be resized.
+   *  @return     Filter mask to be passed to DataSet::writeChunk().
+   *
+   *  @throw hdf5pp::Exception
+   */
+  uint32_t encode(const void* data, size_t size, std::vector<char>& out) const;
+
+  /**
+   *  @brief Undo filters applied to chunk data.
+   *
+   *  @param[in]  data       Filtered chunk data, e.g. from DataSet::readChunk().
+   *  @param[in]  size       Size of filtered data in bytes.
+   *  @param[in]  filterMask Mask of filters that were skipped when chunk was written.
+   *  @param[in]  chunkSize  Size of unfiltered chunk in bytes.
+   *  @param[out] out        Buffer for unfiltered data, will be resized to chunkSize.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void decode(const void* data, size_t size, uint32_t filterMask, size_t chunkSize, std::vector<char>& out) const;
+
+protected:
+
+private:
+
+  // Description of one filter
+  struct Filter {
+    H5Z_filter_t id;                  ///< Filter ID
+    unsigned flags;                   ///< Filter flags
+    std::vector<unsigned> cd_values;  ///< Filter parameters
+  };
+
+  // Data members
+  std::vector<Filter> m_filters;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_FILTERPIPELINE_H
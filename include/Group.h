@@ -15,7 +15,6 @@
 //-----------------
 #include <string>
 #include <iosfwd>
-#include <map>
 #include <boost/shared_ptr.hpp>
 
 //----------------------
@@ -28,9 +27,11 @@
 #include "hdf5/hdf5.h"
 #include "hdf5pp/Attribute.h"
 #include "hdf5pp/DataSet.h"
+#include "hdf5pp/DataSetCache.h"
 #include "hdf5pp/DataSpace.h"
 #include "hdf5pp/PListDataSetAccess.h"
 #include "hdf5pp/PListDataSetCreate.h"
+#include "hdf5pp/PathCache.h"
 
 //------------------------------------
 // Collaborating Class Declarations --
@@ -71,13 +72,13 @@ public:
   /// Create new group, group name treated as relative to this group
   /// (if not absolute).
   Group createGroup ( const std::string& name ) {
-    return createGroup ( *m_id, name ) ;
+    return createGroup ( *m_id, _path(name), m_dsCache, m_pathCache ) ;
   }
 
   /// Open existing group, group name treated as relative to this group
   /// (if not absolute).
   Group openGroup ( const std::string& name ) const {
-    return openGroup ( *m_id, name ) ;
+    return openGroup ( *m_id, _path(name), m_dsCache, m_pathCache ) ;
   }
 
   /// Determines if the group has a child (link) with the given name
@@ -111,7 +112,8 @@ public:
                           const PListDataSetAccess& plistDSaccess = PListDataSetAccess())
   {
     DataSet ds = DataSet::createDataSet ( *m_id, name, TypeTraits<T>::stored_type(), dspc, plistDScreate, plistDSaccess ) ;
-    m_dsCache->insert(std::make_pair(name, ds));
+    m_pathCache->invalidate();
+    m_dsCache->insert(_path(name), ds);
     return ds;
   }
 
@@ -123,7 +125,8 @@ public:
                           const PListDataSetAccess& plistDSaccess = PListDataSetAccess())
   {
     DataSet ds = DataSet::createDataSet ( *m_id, name, type, dspc, plistDScreate, plistDSaccess ) ;
-    m_dsCache->insert(std::make_pair(name, ds));
+    m_pathCache->invalidate();
+    m_dsCache->insert(_path(name), ds);
     return ds;
   }
 
@@ -149,6 +152,21 @@ public:
    */
   std::string getSoftLink(const std::string& linkName) const;
 
+  /**
+   *   @brief Get cache of open datasets.
+   *
+   *   Cache is shared by all groups of the same file, it can be used to change
+   *   the budget of open dataset handles and to get cache statistics.
+   */
+  DataSetCache& dataSetCache() const { return *m_dsCache; }
+
+  /**
+   *   @brief Get cache of resolved paths.
+   *
+   *   Cache is shared by all groups of the same file.
+   */
+  PathCache& pathCache() const { return *m_pathCache; }
+
   // close the group
   void close() ;
 
@@ -175,20 +193,31 @@ protected:
   friend class File ;
   friend class GroupIter ;
 
-  // factory methods
-  static Group createGroup ( hid_t parent, const std::string& name ) ;
-  static Group openGroup ( hid_t parent, const std::string& name ) ;
+  // factory methods, path is absolute, groups share caches with their parent
+  static Group createGroup ( hid_t loc, const std::string& path,
+                             const boost::shared_ptr<DataSetCache>& dsCache,
+                             const boost::shared_ptr<PathCache>& pathCache ) ;
+  static Group openGroup ( hid_t loc, const std::string& path,
+                           const boost::shared_ptr<DataSetCache>& dsCache,
+                           const boost::shared_ptr<PathCache>& pathCache ) ;
 
-  // constructor
-  Group ( hid_t grp ) ;
+  // constructor, path is empty if not known
+  Group ( hid_t grp, const boost::shared_ptr<DataSetCache>& dsCache,
+          const boost::shared_ptr<PathCache>& pathCache, const std::string& path = std::string() ) ;
 
 private:
 
-  typedef std::map<std::string, DataSet> DsCache;
+  // absolute path of an object, name is relative to this group (if not absolute)
+  std::string _path(const std::string& name) const ;
+
+  // collapse repeated slashes and strip trailing slash
+  static std::string _normalize(const std::string& path) ;
 
   // Data members
   boost::shared_ptr<hid_t> m_id ;
-  boost::shared_ptr<DsCache> m_dsCache;
+  boost::shared_ptr<DataSetCache> m_dsCache;
+  boost::shared_ptr<PathCache> m_pathCache;
+  std::string m_path;   ///< Absolute path used to open group, empty if not known
 
 };
 
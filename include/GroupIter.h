@@ -13,6 +13,7 @@
 //-----------------
 // C/C++ Headers --
 //-----------------
+#include <vector>
 
 //----------------------
 // Base Class Headers --
@@ -23,6 +24,7 @@
 //-------------------------------
 #include "hdf5/hdf5.h"
 #include "hdf5pp/Group.h"
+#include "hdf5pp/LinkEntry.h"
 
 //------------------------------------
 // Collaborating Class Declarations --
@@ -41,6 +43,10 @@ namespace hdf5pp {
  *
  *  @brief Class which implements iteration over groups in HDF5 group/file. 
  *
+ *  All links are listed by constructor in a single H5Literate() pass together
+ *  with the types of objects they point to, only sub-groups are opened (by
+ *  their tokens) and they are added to the file path cache.
+ *
  *  This software was developed for the LCLS project.  If you use all or 
  *  part of it, please give an appropriate acknowledgment.
  *
@@ -87,8 +93,8 @@ private:
 
   Group m_group;        ///< Group object
   LinkType m_type;      ///< type of links to include in iteration
-  hsize_t m_nlinks;     ///< Total number of links in a group
-  hsize_t m_idx;        ///< Current index
+  std::vector<LinkEntry> m_entries;   ///< All links in a group
+  size_t m_idx;         ///< Current index
 };
 
 } // namespace hdf5pp
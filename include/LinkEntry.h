@@ -0,0 +1,80 @@
+#ifndef HDF5PP_LINKENTRY_H
+#define HDF5PP_LINKENTRY_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class LinkEntry.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <string>
+#include <vector>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/PathCache.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+class Group;
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Description of one link in a group.
+ *
+ *  Entries for all links in a group are collected by list() in a single
+ *  H5Literate() pass in the same order as used by GroupIter and NameIter.
+ *  Object type and token are determined with H5Oget_info_by_name() without
+ *  opening objects, for soft links they describe the link target. For
+ *  external links and dangling soft links object type is H5O_TYPE_UNKNOWN.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see GroupIter, NameIter
+ *
+ *  @version $Id$
+ */
+
+struct LinkEntry {
+
+  std::string name;           ///< Link name
+  H5L_type_t linkType;        ///< Link type
+  H5O_type_t objType;         ///< Type of the object, H5O_TYPE_UNKNOWN if not known
+  PathCache::Token token;     ///< Object token, only meaningful if object type is known
+
+  /**
+   *  @brief Get entries for all links in a group.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static std::vector<LinkEntry> list(const Group& group);
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_LINKENTRY_H
@@ -14,6 +14,7 @@
 // C/C++ Headers --
 //-----------------
 #include <string>
+#include <vector>
 
 //----------------------
 // Base Class Headers --
@@ -24,6 +25,7 @@
 //-------------------------------
 #include "hdf5/hdf5.h"
 #include "hdf5pp/Group.h"
+#include "hdf5pp/LinkEntry.h"
 
 //------------------------------------
 // Collaborating Class Declarations --
@@ -42,6 +44,9 @@ namespace hdf5pp {
  *
  *  @brief Class which implements iteration over link names in HDF5 group.
  *
+ *  All links are listed by constructor in a single H5Literate() pass,
+ *  iteration does not make any further HDF5 calls and does not open objects.
+ *
  *  This software was developed for the LCLS project.  If you use all or 
  *  part of it, please give an appropriate acknowledgment.
  *
@@ -76,15 +81,23 @@ public:
    *  If there are no more links then empty string will be returned.
    */
   std::string next();
-  
+
+  /**
+   *  @brief Returns next link entry.
+   *
+   *  Returned pointer stays valid while iterator exists, zero pointer is
+   *  returned when there are no more links.
+   */
+  const LinkEntry* nextEntry();
+
 protected:
 
 private:
 
   Group m_group;        ///< Group object
   LinkType m_type;      ///< type of links to include in iteration
-  hsize_t m_nlinks;     ///< Total number of links in a group
-  hsize_t m_idx;        ///< Cuyrrent index
+  std::vector<LinkEntry> m_entries;   ///< All links in a group
+  size_t m_idx;         ///< Current index
 };
 
 } // namespace hdf5pp
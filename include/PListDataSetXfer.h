@@ -0,0 +1,76 @@
+#ifndef HDF5PP_PLISTDATASETXFER_H
+#define HDF5PP_PLISTDATASETXFER_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class PListDataSetXfer.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/PListImpl.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Property list for dataset transfer (reads and writes)
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @version $Id$
+ */
+
+class PListDataSetXfer  {
+public:
+
+  // Default constructor
+  PListDataSetXfer () ;
+
+  // Destructor
+  ~PListDataSetXfer () ;
+
+  // accessor
+  hid_t plist() const { return m_impl.id(); }
+
+  // define memory management functions for variable-length data
+  void set_vlen_mem_manager(H5MM_allocate_t alloc_func, void* alloc_info,
+      H5MM_free_t free_func, void* free_info);
+
+protected:
+
+private:
+
+  // Data members
+  PListImpl m_impl ;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_PLISTDATASETXFER_H
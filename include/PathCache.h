@@ -0,0 +1,181 @@
+#ifndef HDF5PP_PATHCACHE_H
+#define HDF5PP_PATHCACHE_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class PathCache.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+namespace hdf5pp {
+class Catalog;
+}
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Per-file cache of resolved paths.
+ *
+ *  Resolving multi-component paths like "/Configure:0000/Run:0000/CalibCycle:0000"
+ *  needs a B-tree lookup in every group along the path. This cache remembers
+ *  for every absolute path whether a link exists and, once the object was
+ *  opened, its type and object token (object header address before HDF5 1.12)
+ *  so that it can be reopened with H5Oopen_by_token() without traversing the
+ *  path again. Paths which do not exist are also remembered (negative entries).
+ *  Cache can also use a catalog of the file (see setCatalog()), paths which
+ *  are not in cache are then looked up in the catalog.
+ *
+ *  Every file has one cache which is shared by all groups opened from that
+ *  file, it is used by Group::hasChild(), Group::openGroup() and
+ *  Group::parent(). Creating groups, datasets and links through hdf5pp drops
+ *  all negative entries. hdf5pp never removes or moves links, so existing
+ *  entries stay valid; changes made to the file by other means (other
+ *  processes or direct HDF5 calls) require clear().
+ *
+ *  All methods are thread-safe.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see Group
+ *
+ *  @version $Id$
+ */
+
+class PathCache  {
+public:
+
+#if H5_VERSION_GE(1,12,0)
+  typedef H5O_token_t Token;
+#else
+  typedef haddr_t Token;
+#endif
+
+  /// Result of path lookup
+  enum Status { Unknown, Missing, Exists };
+
+  /// Cached data for existing path
+  struct Entry {
+    Entry() : type(H5O_TYPE_UNKNOWN), token() {}
+    H5O_type_t type;    ///< Object type, H5O_TYPE_UNKNOWN if object was not opened yet
+    Token token;        ///< Object token, only meaningful if type is known
+  };
+
+  // Default constructor
+  PathCache() ;
+
+  // Destructor
+  ~PathCache() ;
+
+  /**
+   *  @brief Find path in cache.
+   *
+   *  Returns Unknown if path is not in cache, Missing if path is known to
+   *  not exist, Exists if link exists, in the last case entry is filled.
+   */
+  Status find(const std::string& path, Entry& entry);
+
+  /// Remember that link exists, entry with known type replaces existing entry.
+  void insert(const std::string& path, const Entry& entry = Entry());
+
+  /// Remember that link does not exist.
+  void insertMissing(const std::string& path);
+
+  /**
+   *  @brief Use catalog of the file for lookups.
+   *
+   *  Catalog is not copied into cache, paths which are not in cache are
+   *  looked up in the catalog when they are requested. Catalog must describe
+   *  the same file, its objects are treated as existing, paths which are not
+   *  in catalog are still checked in the file. Catalog is dropped by clear().
+   */
+  void setCatalog(const Catalog& catalog);
+
+  /// Drop all negative entries, called when new objects or links are created.
+  void invalidate();
+
+  /// Remove all entries and catalog.
+  void clear();
+
+  /// Get number of entries in cache, positive and negative.
+  size_t size() const;
+
+  /// Get number of lookups which found path in cache.
+  unsigned long hits() const;
+
+  /// Get number of lookups which did not find path in cache.
+  unsigned long misses() const;
+
+  /**
+   *  @brief Get type and token of an open object.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Entry objectInfo(hid_t id);
+
+  /**
+   *  @brief Open object by its token.
+   *
+   *  @param[in] loc    Any object in the same file.
+   *  @param[in] entry  Entry with known type.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static hid_t open(hid_t loc, const Entry& entry);
+
+protected:
+
+private:
+
+  typedef boost::unordered_map<std::string, Entry> Entries;
+  typedef boost::unordered_set<std::string> MissingPaths;
+
+  // Copy constructor and assignment are disabled by default
+  PathCache ( const PathCache& ) ;
+  PathCache& operator = ( const PathCache& ) ;
+
+  // Data members
+  mutable boost::mutex m_mutex;   ///< Protects all members
+  Entries m_entries;              ///< Existing paths
+  MissingPaths m_missing;         ///< Paths which do not exist
+  boost::shared_ptr<const Catalog> m_catalog;  ///< Catalog of the file, may be zero
+  unsigned long m_hits;           ///< Number of lookups found in cache
+  unsigned long m_misses;         ///< Number of lookups not found in cache
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_PATHCACHE_H
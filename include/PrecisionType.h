@@ -0,0 +1,130 @@
+#ifndef HDF5PP_PRECISIONTYPE_H
+#define HDF5PP_PRECISIONTYPE_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class PrecisionType.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/Type.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Stored types with reduced precision.
+ *
+ *  Methods of this class make numeric types which keep fewer significant
+ *  bits than native types, they are meant to be used as stored types for
+ *  data which do not need full precision (e.g. noise-dominated detector
+ *  data). HDF5 converts native data to these types on write and back on
+ *  read. Types with precision smaller than their size only save space
+ *  when dataset uses n-bit filter (PListDataSetCreate::set_nbit()), which
+ *  packs significant bits of each element. Example:
+ *
+ *  @code
+ *  // store float data with 10-bit mantissa packed by n-bit filter
+ *  hdf5pp::PListDataSetCreate plist;
+ *  plist.set_chunk(2, chunk);
+ *  plist.set_nbit();
+ *  hdf5pp::Utils::storeNDArray(group, "data", array, hdf5pp::TypeTraits<float>::native_type(),
+ *      hdf5pp::PrecisionType::truncatedFloat(10), plist);
+ *  @endcode
+ *
+ *  All returned types are locked and cached.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see PListDataSetCreate::set_nbit
+ *
+ *  @version $Id$
+ */
+
+class PrecisionType  {
+public:
+
+  /**
+   *  @brief IEEE 754 half-precision (16-bit) floating point type.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type float16() { return floatType(5, 10); }
+
+  /**
+   *  @brief Floating point type with given exponent and mantissa sizes.
+   *
+   *  Type has IEEE-like layout (sign, exponent, mantissa with implied leading
+   *  bit) and the smallest size in bytes which fits all bits.
+   *
+   *  @param[in] ebits  Number of exponent bits, 2 to 11.
+   *  @param[in] mbits  Number of mantissa bits, 1 to 52.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type floatType(unsigned ebits, unsigned mbits);
+
+  /**
+   *  @brief Single-precision float type with mantissa truncated to given number of bits.
+   *
+   *  Type has the same size, sign and exponent as float type, mbits most
+   *  significant bits of mantissa are kept, lower bits are outside of type
+   *  precision. Range of values is the same as for float type.
+   *
+   *  @param[in] mbits  Number of mantissa bits, 1 to 23.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type truncatedFloat(unsigned mbits);
+
+  /**
+   *  @brief Integer type with reduced precision.
+   *
+   *  @param[in] baseType   Integer type, e.g. TypeTraits<uint16_t>::stored_type().
+   *  @param[in] precision  Number of significant bits.
+   *  @param[in] offset     Offset of the first significant bit, bits below
+   *                        offset are dropped.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type integerType(const Type& baseType, unsigned precision, unsigned offset = 0);
+
+protected:
+
+private:
+
+  // This class is not supposed to be instantiated
+  PrecisionType();
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_PRECISIONTYPE_H
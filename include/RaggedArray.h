@@ -0,0 +1,76 @@
+#ifndef HDF5PP_RAGGEDARRAY_H
+#define HDF5PP_RAGGEDARRAY_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class RaggedArray.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "ndarray/ndarray.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Rows of different length in compressed sparse row (CSR) layout.
+ *
+ *  Values of all rows are stored contiguously in values array, offsets array
+ *  has one more element than the number of rows, row i occupies values from
+ *  offsets[i] to offsets[i+1]. This is the in-memory format for the ranges of
+ *  VLEN datasets read by Utils::readRagged() and written by Utils::storeRagged().
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see Utils::readRagged
+ *
+ *  @version $Id$
+ */
+
+template <typename T>
+struct RaggedArray {
+
+  ndarray<uint64_t, 1> offsets;   ///< Offsets of rows in values array, size is number of rows plus one
+  ndarray<T, 1> values;           ///< Values of all rows
+
+  /// Get number of rows
+  size_t size() const { return offsets.size() > 0 ? offsets.size() - 1 : 0; }
+
+  /// Get pointer to the first value of a row
+  T* row(size_t i) const { return values.data() + offsets.data()[i]; }
+
+  /// Get number of values in a row
+  size_t rowSize(size_t i) const { return offsets.data()[i+1] - offsets.data()[i]; }
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_RAGGEDARRAY_H
@@ -0,0 +1,139 @@
+#ifndef HDF5PP_ROWAPPENDER_H
+#define HDF5PP_ROWAPPENDER_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class RowAppender.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/DataSet.h"
+#include "hdf5pp/Type.h"
+#include "hdf5pp/TypeTraits.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Buffered appender of rows to a set of rank-1 datasets.
+ *
+ *  Row is a set of records, one record per dataset ("column"). All columns
+ *  are kept at the same length, each append() adds one record to every
+ *  column. Rows are collected in memory and written with one extent change
+ *  per dataset and one write for all datasets, the latter is done with
+ *  H5Dwrite_multi() when HDF5 library provides it (1.14 and later), otherwise
+ *  with one H5Dwrite() per dataset. Default buffer size is the smallest chunk
+ *  size of all datasets.
+ *
+ *  Columns are added with add() before the first row is appended, all
+ *  datasets must be rank-1 extensible datasets of the same size. Like with
+ *  DataSetAppender, objects have reference semantics and buffered rows are
+ *  written by flush() or when the last copy is destroyed.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see DataSetAppender
+ *
+ *  @version $Id$
+ */
+
+class RowAppender  {
+public:
+
+  /**
+   *  @brief Make appender without columns.
+   *
+   *  @param[in] bufSize  Buffer size in rows, if zero then smallest chunk size is used.
+   */
+  explicit RowAppender(hsize_t bufSize = 0);
+
+  // Destructor
+  ~RowAppender() ;
+
+  /**
+   *  @brief Add one column.
+   *
+   *  @param[in] ds          Rank-1 extensible dataset, must have the same size as other columns.
+   *  @param[in] native_type In-memory type of the records.
+   *  @return Column index.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  unsigned add(const DataSet& ds, const Type& native_type);
+
+  /// Add one column with in-memory type determined from TypeTraits<T>.
+  template <typename T>
+  unsigned add(const DataSet& ds) { return add(ds, TypeTraits<T>::native_type()); }
+
+  /**
+   *  @brief Add one row.
+   *
+   *  Array of pointers must have one pointer per column in the order in which
+   *  columns were added, each pointer points to an object of the column type.
+   *  If buffer becomes full it is flushed to datasets.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void append(const void* const row[]);
+
+  /**
+   *  @brief Write all buffered rows to datasets.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  void flush();
+
+  /// Get number of columns
+  unsigned columns() const;
+
+  /// Get number of rows including rows which are still in buffer
+  hsize_t size() const;
+
+  /// Get number of rows in buffer which have not been written yet
+  hsize_t buffered() const;
+
+  /// Get dataset object for given column
+  DataSet dataSet(unsigned column) const;
+
+protected:
+
+private:
+
+  struct Impl;
+
+  // Data members
+  boost::shared_ptr<Impl> m_impl;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_ROWAPPENDER_H
@@ -88,6 +88,15 @@ public:
   /// set type precision
   void set_precision( size_t precision ) ;
 
+  /// set bit offset of the first significant bit
+  void set_offset( size_t offset ) ;
+
+  /// set floating point bit field positions and sizes
+  void set_fields( size_t spos, size_t epos, size_t esize, size_t mpos, size_t msize ) ;
+
+  /// set floating point exponent bias
+  void set_ebias( size_t ebias ) ;
+
   // returns true if there is a real object behind
   bool valid() const { return m_id.get() ; }
 
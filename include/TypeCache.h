@@ -0,0 +1,134 @@
+#ifndef HDF5PP_TYPECACHE_H
+#define HDF5PP_TYPECACHE_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class TypeCache.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <string>
+#include <vector>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/ArrayType.h"
+#include "hdf5pp/Type.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Process-wide cache of derived types.
+ *
+ *  Creating array and string types for every read or write of a record means
+ *  new HDF5 type objects and new handles each time. This class keeps one
+ *  locked type for every distinct array type (base type, rank, dimensions),
+ *  fixed-size string type and compound subset type, repeated requests return
+ *  the same type ID. Base types are matched first by ID and then structurally
+ *  with H5Tequal(), so compound types which are re-built on every call are
+ *  also found in cache.
+ *  Cached types stay alive until the end of the process, they are locked and
+ *  cannot be modified.
+ *
+ *  All methods are thread-safe, cache is protected by a mutex which is held
+ *  only for the lookup. Lookup which does not find base type by ID compares
+ *  it with H5Tequal(), pass the same type objects (e.g. from TypeRegistry)
+ *  on every call for the cheapest lookups. Types which are used in hot
+ *  loops are better obtained once and kept by the caller.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see TypeTraits
+ *
+ *  @version $Id$
+ */
+
+class TypeCache  {
+public:
+
+  /**
+   *  @brief Get array type.
+   *
+   *  @param[in] baseType  Type of array elements.
+   *  @param[in] rank      Array rank.
+   *  @param[in] dims      Array dimensions.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static ArrayType arrayType(const Type& baseType, unsigned rank, const hsize_t dims[]);
+
+  /// Get rank-1 array type.
+  static ArrayType arrayType(const Type& baseType, hsize_t dim) { return arrayType(baseType, 1, &dim); }
+
+  /**
+   *  @brief Get fixed-size string type.
+   *
+   *  @param[in] size  String size including terminating zero.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type stringType(size_t size);
+
+  /**
+   *  @brief Get subset of compound type.
+   *
+   *  Returned compound type has the same size as the original type and
+   *  contains only listed members at their original offsets.
+   *
+   *  @param[in] compoundType  Compound type.
+   *  @param[in] members       Names of the members to keep.
+   *
+   *  @throw hdf5pp::Exception if type is not compound or does not have listed members
+   */
+  static Type subsetType(const Type& compoundType, const std::vector<std::string>& members);
+
+  /**
+   *  @brief Make locked copy of a type.
+   *
+   *  Copy is never released and can be shared between all users of the type,
+   *  this is used for types which are built once and kept in static variables.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type lockedCopy(const Type& type);
+
+  /// Get number of types in cache.
+  static size_t size();
+
+protected:
+
+private:
+
+  // This class is not supposed to be instantiated
+  TypeCache();
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_TYPECACHE_H
@@ -0,0 +1,110 @@
+#ifndef HDF5PP_TYPEREGISTRY_H
+#define HDF5PP_TYPEREGISTRY_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class TypeRegistry.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/Type.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Thread-safe registry of user-defined types.
+ *
+ *  User types are identified by the function which builds them. Resulting
+ *  type is locked and kept until the end of the process. Lookups of registered
+ *  types do not take any locks, so many threads can start reading at the same
+ *  time. Factory may itself call get() for the types of compound members.
+ *  Typical use is in the native_type() method of user class:
+ *
+ *  @code
+ *  struct Record {
+ *    static hdf5pp::Type native_type() { return hdf5pp::TypeRegistry::get(&makeNativeType); }
+ *    static hdf5pp::Type makeNativeType();
+ *    ...
+ *  };
+ *  @endcode
+ *
+ *  Method warmup() creates types for all built-in TypeTraits, it can be
+ *  called together with add() for user types before reader threads start.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see TypeCache
+ *
+ *  @version $Id$
+ */
+
+class TypeRegistry  {
+public:
+
+  /// Function which builds a type
+  typedef Type (*Factory)();
+
+  /**
+   *  @brief Get type built by a factory function.
+   *
+   *  Factory is called on the first request only. Factory calls are
+   *  serialized by a recursive mutex, so other threads requesting new types
+   *  wait while factory runs, and factory may call get() for its members.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static Type get(Factory factory);
+
+  /// Register type in advance, same as get() with result ignored.
+  static void add(Factory factory) { get(factory); }
+
+  /**
+   *  @brief Create types for all built-in TypeTraits.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static void warmup();
+
+  /// Get number of registered user types
+  static size_t size();
+
+protected:
+
+private:
+
+  // This class is not supposed to be instantiated
+  TypeRegistry();
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_TYPEREGISTRY_H
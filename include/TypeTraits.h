@@ -72,10 +72,14 @@ template <typename T>
 struct TypeTraits<const T> : public TypeTraits<T> {
 };
 
+// type objects for simple types are created once, copies share the same handle
 #define TYPE_TRAITS_SIMPLE(CPP_TYPE,H5_TYPE) \
   template <> struct TypeTraits<CPP_TYPE> { \
-    static Type stored_type(size_t size=0) { return TypeTraitsHelper::sized_h5type(Type::LockedType(H5_TYPE), size); } \
-    static Type native_type(size_t size=0) { return TypeTraitsHelper::sized_h5type(Type::LockedType(H5_TYPE), size); } \
+    static Type stored_type(size_t size=0) { return native_type(size); } \
+    static Type native_type(size_t size=0) { \
+      static const Type type = Type::LockedType(H5_TYPE); \
+      return TypeTraitsHelper::sized_h5type(type, size); \
+    } \
     static const void* address( const CPP_TYPE& value ) { return static_cast<const void*>(&value) ; } \
     static void* address( CPP_TYPE& value ) { return static_cast<void*>(&value) ; } \
   }
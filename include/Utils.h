@@ -13,6 +13,7 @@
 //-----------------
 // C/C++ Headers --
 //-----------------
+#include <algorithm>
 #include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -25,8 +26,13 @@
 // Collaborating Class Headers --
 //-------------------------------
 #include "hdf5pp/ArrayType.h"
+#include "hdf5pp/ChunkReader.h"
+#include "hdf5pp/Columns.h"
 #include "hdf5pp/DataSet.h"
 #include "hdf5pp/Group.h"
+#include "hdf5pp/RaggedArray.h"
+#include "hdf5pp/TypeCache.h"
+#include "hdf5pp/VlenArena.h"
 #include "hdf5pp/VlenType.h"
 #include "ndarray/ndarray.h"
 
@@ -88,6 +94,26 @@ public:
     return ptr;
   }
 
+  /**
+   *  @brief Read one object from dataset into existing object.
+   *
+   *  Same as readDataSet(ds, index) but stores data in the object provided by
+   *  caller instead of allocating new one.
+   *
+   *  @param[in]  ds    dataset object
+   *  @param[out] data  Object to fill
+   *  @param[in]  index Object index, if negative then dataset must be scalar
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename Data>
+  static void readDataSetInto(hdf5pp::DataSet ds, Data* data, hsize_t index = -1)
+  {
+    hdf5pp::DataSpace file_dsp = ds.dataSpace();
+    if (index != hsize_t(-1)) file_dsp.select_single(index);
+    ds.read(hdf5pp::DataSpace::makeScalar(), file_dsp, data, TypeTraits<Data>::native_type());
+  }
+
 
   /**
    *  @brief Read ndarray from dataset.
@@ -107,88 +133,164 @@ public:
   template <typename Data, unsigned Rank>
   static ndarray<Data, Rank> readNdarray(hdf5pp::DataSet ds, hsize_t index = -1)
   {
-    hdf5pp::DataSpace file_dsp = ds.dataSpace();
+    hdf5pp::DataSpace file_dsp;
     hdf5pp::DataSpace mem_dsp;
     Type memType;
-
     hsize_t dims[Rank];
-    if (index == hsize_t(-1)) {
 
-      // read whole dataset, has to know its rank and dimensions
-      
-      if (file_dsp.get_simple_extent_type() == H5S_NULL) {
-      
-        // translator saves empty datasets with H5S_NULL dataspace
-        // in this case create 0-sized array
-        std::fill_n(dims, Rank, hsize_t(0));
-        
-      } else {
-       
-        unsigned rank = file_dsp.rank();
-  
-        // check rank
-        if (rank != Rank) throw Hdf5RankMismatch(ERR_LOC, Rank, rank);
-  
-        file_dsp.dimensions(dims);
-        mem_dsp = DataSpace::makeSimple(Rank, dims, dims);
-  
-        memType = TypeTraits<Data>::native_type();
-        
-      }
+    if (_readSetup<Data, Rank>(ds, index, dims, file_dsp, mem_dsp, memType)) {
 
-    } else {
+      // read data in VLEN structure
+      hvl_t vl_data;
+      ds.read(mem_dsp, file_dsp, &vl_data, memType);
 
-      // select single item for dataset
-      file_dsp.select_single(index);
-      mem_dsp = DataSpace::makeScalar();
+      // steal a pointer, it has to be free()d
+      boost::shared_ptr<Data> shptr(static_cast<Data*>(vl_data.p), Unmalloc<Data>());
 
-      // read one element from rank-1 dataset, element of a dataset must
-      // have array type or VLEN type
+      unsigned shape[] = { unsigned(vl_data.len) };
+      return ndarray<Data, Rank>(shptr, shape);
+    }
 
-      hdf5pp::Type etype = ds.type();
-      if (etype.tclass() == H5T_VLEN) {
+    // make ndarray
+    unsigned shape[Rank];
+    std::copy(dims, dims+Rank, shape);
+    ndarray<Data, Rank> array(shape);
 
-        // read whole VLEN, Rank must be 1
-        if (Rank != 1) throw Hdf5RankMismatch(ERR_LOC, Rank, 1);
+    if (array.size() > 0) {
+      // read it
+      ds.read(mem_dsp, file_dsp, array.data(), memType);
+    }
+    
+    return array;
 
-        // Memory type is VLEN
-        memType = VlenType::vlenType(TypeTraits<Data>::native_type());
+  }
 
-        // read data in VLEN structure
-        hvl_t vl_data;
-        ds.read(mem_dsp, file_dsp, &vl_data, memType);
+  /**
+   *  @brief Read ndarray from dataset, VLEN data are allocated from arena.
+   *
+   *  Same as readNdarray(ds, index) but for VLEN data memory is allocated from
+   *  arena instead of malloc(), returned array keeps arena region alive. New
+   *  arena region is started after reading when current region grows above
+   *  its limit. Non-VLEN data are read as usual.
+   *
+   *  @param[in] ds     dataset object
+   *  @param[in] arena  Arena for VLEN data.
+   *  @param[in] index  Object index, if negative then whole dataset is read.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename Data, unsigned Rank>
+  static ndarray<Data, Rank> readNdarray(hdf5pp::DataSet ds, VlenArena& arena, hsize_t index = -1)
+  {
+    hdf5pp::DataSpace file_dsp;
+    hdf5pp::DataSpace mem_dsp;
+    Type memType;
+    hsize_t dims[Rank];
 
-        // steal a pointer, it has to be free()d
-        boost::shared_ptr<Data> shptr(static_cast<Data*>(vl_data.p), Unmalloc<Data>());
+    if (not _readSetup<Data, Rank>(ds, index, dims, file_dsp, mem_dsp, memType)) {
+      unsigned shape[Rank];
+      std::copy(dims, dims+Rank, shape);
+      ndarray<Data, Rank> array(shape);
+      if (array.size() > 0) ds.read(mem_dsp, file_dsp, array.data(), memType);
+      return array;
+    }
 
-        unsigned shape[] = { unsigned(vl_data.len) };
-        return ndarray<Data, Rank>(shptr, shape);
+    hvl_t vl_data;
+    ds.read(mem_dsp, file_dsp, &vl_data, memType, arena.xferPlist());
+    boost::shared_ptr<Data> shptr = arena.share(static_cast<Data*>(vl_data.p));
+    arena.maybeNewRegion();
 
-      }
+    unsigned shape[] = { unsigned(vl_data.len) };
+    return ndarray<Data, Rank>(shptr, shape);
+  }
 
-      // this will throw if type of data is not an array
-      ArrayType type = ArrayType(ds.type());
+  /**
+   *  @brief Read ndarray from dataset into existing array.
+   *
+   *  Same as readNdarray(ds, index) but data are stored in the existing array
+   *  instead of a newly allocated one. Array shape must be the same as the shape
+   *  of the data in dataset. This is useful in loops which read the data of the
+   *  same shape many times, no memory is allocated for the data (except VLEN
+   *  data which are allocated by HDF5 and copied).
+   *
+   *  @param[in] ds    dataset object
+   *  @param[out] array Array to fill, must have correct shape.
+   *  @param[in] index Object index, if negative then whole dataset is read.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename Data, unsigned Rank>
+  static void readNdarray(hdf5pp::DataSet ds, ndarray<Data, Rank>& array, hsize_t index = -1)
+  {
+    hdf5pp::DataSpace file_dsp;
+    hdf5pp::DataSpace mem_dsp;
+    Type memType;
+    hsize_t dims[Rank];
 
-      // check array type rank, get dimensions
-      unsigned rank = type.rank();
-      if (rank != Rank) throw Hdf5RankMismatch(ERR_LOC, Rank, rank);
-      type.dimensions(dims);
+    if (_readSetup<Data, Rank>(ds, index, dims, file_dsp, mem_dsp, memType)) {
 
-      memType = ArrayType::arrayType(TypeTraits<Data>::native_type(), Rank, dims);
+      // VLEN data are always allocated by HDF5, copy and release them
+      hvl_t vl_data;
+      ds.read(mem_dsp, file_dsp, &vl_data, memType);
+      boost::shared_ptr<Data> shptr(static_cast<Data*>(vl_data.p), Unmalloc<Data>());
+      if (vl_data.len != array.shape()[0]) throw Hdf5DataSpaceSizeException(ERR_LOC);
+      std::copy(shptr.get(), shptr.get()+vl_data.len, array.data());
+      return;
     }
 
-    // make ndarray
-    unsigned shape[Rank];
-    std::copy(dims, dims+Rank, shape);
-    ndarray<Data, Rank> array(shape);
-
+    if (not std::equal(dims, dims+Rank, array.shape())) throw Hdf5DataSpaceSizeException(ERR_LOC);
     if (array.size() > 0) {
-      // read it
       ds.read(mem_dsp, file_dsp, array.data(), memType);
     }
-    
-    return array;
+  }
 
+  /**
+   *  @brief Read ndarray data from dataset into caller-provided buffer.
+   *
+   *  Same as readNdarray(ds, index) but data are stored in the buffer provided
+   *  by caller and their shape is returned in shape argument. An exception is
+   *  thrown if buffer is too small for the data, buffer may be modified in this
+   *  case.
+   *
+   *  @param[in]  ds       dataset object
+   *  @param[out] data     Buffer for the data
+   *  @param[in]  capacity Size of buffer in objects of type Data
+   *  @param[out] shape    Shape of the data, array of Rank elements
+   *  @param[in]  index    Object index, if negative then whole dataset is read.
+   *  @return     Number of objects read
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename Data, unsigned Rank>
+  static size_t readNdarray(hdf5pp::DataSet ds, Data* data, size_t capacity, unsigned shape[], hsize_t index = -1)
+  {
+    hdf5pp::DataSpace file_dsp;
+    hdf5pp::DataSpace mem_dsp;
+    Type memType;
+    hsize_t dims[Rank];
+
+    if (_readSetup<Data, Rank>(ds, index, dims, file_dsp, mem_dsp, memType)) {
+
+      // VLEN data are always allocated by HDF5, copy and release them
+      hvl_t vl_data;
+      ds.read(mem_dsp, file_dsp, &vl_data, memType);
+      boost::shared_ptr<Data> shptr(static_cast<Data*>(vl_data.p), Unmalloc<Data>());
+      if (vl_data.len > capacity) throw Hdf5DataSpaceSizeException(ERR_LOC);
+      std::copy(shptr.get(), shptr.get()+vl_data.len, data);
+      shape[0] = vl_data.len;
+      return vl_data.len;
+    }
+
+    size_t size = 1;
+    for (unsigned i = 0; i != Rank; ++ i) size *= dims[i];
+    if (size > capacity) throw Hdf5DataSpaceSizeException(ERR_LOC);
+    std::copy(dims, dims+Rank, shape);
+
+    if (size > 0) {
+      ds.read(mem_dsp, file_dsp, data, memType);
+    }
+
+    return size;
   }
 
 
@@ -230,6 +332,157 @@ public:
     return readNdarray<Data, Rank>(group.openDataSet(dataset), index);
   }
 
+  /**
+   *  @brief Read ndarray from a named dataset, VLEN data are allocated from arena.
+   *
+   *  @param[in] group    Group object, parent of the dataset.
+   *  @param[in] dataset  Dataset name
+   *  @param[in] arena    Arena for VLEN data.
+   *  @param[in] index    Object index, if negative then whole dataset is read.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename Data, unsigned Rank>
+  static ndarray<Data, Rank> readNdarray(hdf5pp::Group group, const std::string& dataset, VlenArena& arena,
+      hsize_t index = -1)
+  {
+    return readNdarray<Data, Rank>(group.openDataSet(dataset), arena, index);
+  }
+
+  /**
+   *  @brief Read ndarray from a named dataset into existing array.
+   *
+   *  @param[in]  group   Group object, parent of the dataset.
+   *  @param[in]  dataset Dataset name
+   *  @param[out] array   Array to fill, must have correct shape.
+   *  @param[in]  index   Object index, if negative then whole dataset is read.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename Data, unsigned Rank>
+  static void readNdarray(hdf5pp::Group group, const std::string& dataset, ndarray<Data, Rank>& array,
+      hsize_t index = -1)
+  {
+    readNdarray<Data, Rank>(group.openDataSet(dataset), array, index);
+  }
+
+  /**
+   *  @brief Read whole dataset into ndarray using parallel decompression.
+   *
+   *  Result is the same as from readNdarray(ds) but for compressed chunked datasets
+   *  chunks are decompressed by a pool of threads, see ChunkReader. Datasets which
+   *  cannot be read this way are read with a single H5Dread().
+   *
+   *  @param[in] ds       dataset object
+   *  @param[in] nThreads Number of decompression threads, 0 means number of CPU cores.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename Data, unsigned Rank>
+  static ndarray<Data, Rank> readNdarrayParallel(hdf5pp::DataSet ds, unsigned nThreads = 0)
+  {
+    ChunkReader reader(ds, nThreads);
+    if (not reader.supported(TypeTraits<Data>::native_type())) return readNdarray<Data, Rank>(ds);
+    return reader.read<Data, Rank>();
+  }
+
+  /**
+   *  @brief Read ndarray from a named dataset using parallel decompression.
+   *
+   *  @param[in] group    Group object, parent of the dataset.
+   *  @param[in] dataset  Dataset name
+   *  @param[in] nThreads Number of decompression threads, 0 means number of CPU cores.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename Data, unsigned Rank>
+  static ndarray<Data, Rank> readNdarrayParallel(hdf5pp::Group group, const std::string& dataset, unsigned nThreads = 0)
+  {
+    return readNdarrayParallel<Data, Rank>(group.openDataSet(dataset), nThreads);
+  }
+
+  /**
+   *  @brief Read members of compound rank-1 dataset into separate arrays.
+   *
+   *  Range of records is read one chunk at a time, for every column the data
+   *  are read with a memory type containing just that member, so values go
+   *  directly into column arrays without array-of-structures copy in memory.
+   *  Member reads of the same chunk are served from the chunk cache, chunk
+   *  cache of the dataset should be large enough to hold one chunk. Members
+   *  of variable-length types are not supported.
+   *
+   *  @param[in]     ds       Dataset object.
+   *  @param[in,out] columns  Columns to read, arrays are re-allocated.
+   *  @param[in]     start    Index of the first record.
+   *  @param[in]     count    Number of records, reads till the end of dataset if
+   *                          larger than number of remaining records.
+   *  @return        Number of records read.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static hsize_t readColumns(hdf5pp::DataSet ds, Columns& columns, hsize_t start = 0, hsize_t count = -1);
+
+  /**
+   *  @brief Read members of named compound dataset into separate arrays.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  static hsize_t readColumns(hdf5pp::Group group, const std::string& dataset, Columns& columns,
+      hsize_t start = 0, hsize_t count = -1)
+  {
+    return readColumns(group.openDataSet(dataset), columns, start, count);
+  }
+
+  /**
+   *  @brief Read range of rows from rank-1 VLEN dataset.
+   *
+   *  All rows are read with a single H5Dread() call, VLEN data are allocated
+   *  from a temporary arena and copied into contiguous values array.
+   *
+   *  @param[in] ds     Dataset object.
+   *  @param[in] begin  Index of the first row.
+   *  @param[in] end    Index after the last row, if larger than dataset size
+   *                    then rows till the end of dataset are read.
+   *  @param[in] native_type  In-memory type of the values.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename T>
+  static RaggedArray<T> readRagged(hdf5pp::DataSet ds, hsize_t begin = 0, hsize_t end = -1,
+      const Type& native_type = TypeTraits<T>::native_type())
+  {
+    VlenArena arena;
+    std::vector<hvl_t> rows;
+    _readRagged(ds, begin, end, native_type, arena, rows);
+
+    RaggedArray<T> result;
+    unsigned oshape[] = { unsigned(rows.size() + 1) };
+    result.offsets = ndarray<uint64_t, 1>(oshape);
+    uint64_t* offsets = result.offsets.data();
+    offsets[0] = 0;
+    for (size_t i = 0; i != rows.size(); ++ i) offsets[i+1] = offsets[i] + rows[i].len;
+
+    unsigned vshape[] = { unsigned(offsets[rows.size()]) };
+    result.values = ndarray<T, 1>(vshape);
+    for (size_t i = 0; i != rows.size(); ++ i) {
+      const T* p = static_cast<const T*>(rows[i].p);
+      std::copy(p, p + rows[i].len, result.values.data() + offsets[i]);
+    }
+    return result;
+  }
+
+  /**
+   *  @brief Read range of rows from named rank-1 VLEN dataset.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename T>
+  static RaggedArray<T> readRagged(hdf5pp::Group group, const std::string& dataset, hsize_t begin = 0,
+      hsize_t end = -1, const Type& native_type = TypeTraits<T>::native_type())
+  {
+    return readRagged<T>(group.openDataSet(dataset), begin, end, native_type);
+  }
+
   /**
    *  @brief Store an object in a dataset in a group.
    *
@@ -261,6 +514,9 @@ public:
    *  if index exceeds current dataset size then dataset size is extended to index+1
    *  and all new entries are zero-filled. New object is then stored at specified index.
    *
+   *  This method opens dataset, extends it and writes single object for every call,
+   *  for appending many objects to the same dataset DataSetAppender is much more efficient.
+   *
    *  @param[in] group   Group object, parent of the dataset.
    *  @param[in] dataset Dataset name
    *  @param[in] data    Object to store
@@ -298,6 +554,30 @@ public:
     _storeArray(group, dataset, static_cast<const void*>(array.data()), NDim, array.shape(), native_type, stored_type);
   }
 
+  /**
+   *  @brief Store ndarray in a dataset in a group, give dataset creation property list.
+   *
+   *  Same as above but dataset is created with the given property list, e.g. with
+   *  chunking and n-bit filter for stored types with reduced precision (see
+   *  PrecisionType). Property list is not used for empty arrays.
+   *
+   *  @param[in] group   Group object, parent of the dataset.
+   *  @param[in] dataset Dataset name
+   *  @param[in] array   Object to store
+   *  @param[in] native_type    In-memory type of the data
+   *  @param[in] stored_type    Type of the data as stored in file
+   *  @param[in] plistDScreate  Dataset creation property list
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename ElemType, unsigned NDim>
+  static void storeNDArray(hdf5pp::Group group, const std::string& dataset, const ndarray<ElemType, NDim>& array,
+      const Type& native_type, const Type& stored_type, const PListDataSetCreate& plistDScreate)
+  {
+    _storeArray(group, dataset, static_cast<const void*>(array.data()), NDim, array.shape(), native_type,
+        stored_type, plistDScreate);
+  }
+
   /**
    *  @brief Store ndarray at specified index in a dataset in a group.
    *
@@ -334,7 +614,7 @@ public:
       long index, const Type& native_type = TypeTraits<ElemType>::native_type())
   {
     std::vector<hsize_t> dims(array.shape(), array.shape()+NDim);
-    ArrayType array_native = ArrayType::arrayType(native_type, NDim, &dims.front());
+    ArrayType array_native = TypeCache::arrayType(native_type, NDim, &dims.front());
     _storeAt(group, dataset, static_cast<const void*>(array.data()), index, array_native);
   }
 
@@ -354,13 +634,52 @@ public:
   static DataSet createDataset(hdf5pp::Group group, const std::string& dataset, const Type& stored_type,
       hsize_t chunk_size, hsize_t chunk_cache_size, int deflate, bool shuffle);
 
+  /**
+   *  @brief Store rows in rank-1 VLEN dataset.
+   *
+   *  All rows are written with a single H5Dwrite() call directly from values
+   *  array. Dataset is extended if needed, it must be extensible then.
+   *
+   *  @param[in] ds     Dataset object.
+   *  @param[in] data   Rows to store.
+   *  @param[in] begin  Index of the first row in dataset, if negative then rows
+   *                    are appended at the end of dataset.
+   *  @param[in] native_type  In-memory type of the values.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename T>
+  static void storeRagged(hdf5pp::DataSet ds, const RaggedArray<T>& data, long begin = -1,
+      const Type& native_type = TypeTraits<T>::native_type())
+  {
+    std::vector<hvl_t> rows(data.size());
+    for (size_t i = 0; i != rows.size(); ++ i) {
+      rows[i].len = data.rowSize(i);
+      rows[i].p = const_cast<T*>(data.row(i));
+    }
+    _storeRagged(ds, rows, begin, native_type);
+  }
+
+  /**
+   *  @brief Store rows in named rank-1 VLEN dataset.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  template <typename T>
+  static void storeRagged(hdf5pp::Group group, const std::string& dataset, const RaggedArray<T>& data,
+      long begin = -1, const Type& native_type = TypeTraits<T>::native_type())
+  {
+    storeRagged<T>(group.openDataSet(dataset), data, begin, native_type);
+  }
+
   /**
    *  @brief Resize rank-1 dataset.
    *
    *  Extends dataset to a new size (has to be a rank-1 dataset). If size given as argument
    *  is negative this is equivalent to extending the size by one element. New added elements
    *  will be default-initialized (zero-filled unless dataset type defines special default values).
-   *  This method can also be used to shrink dataset size.
+   *  This method can also be used to shrink dataset size. If dataset has extent reservation
+   *  enabled (see DataSet::set_reserve()) then this method changes its logical size.
    *
    *  @param[in] group         Group object, parent of the dataset.
    *  @param[in] dataset       Dataset name
@@ -371,6 +690,93 @@ public:
 
 private:
 
+  /**
+   *  Common part of readNdarray() methods, determines data dimensions, dataspaces and
+   *  in-memory type. Returns true if indexed element is VLEN, in this case dims are not
+   *  set and memType is VLEN type.
+   */
+  template <typename Data, unsigned Rank>
+  static bool _readSetup(hdf5pp::DataSet& ds, hsize_t index, hsize_t dims[],
+      hdf5pp::DataSpace& file_dsp, hdf5pp::DataSpace& mem_dsp, Type& memType)
+  {
+    file_dsp = ds.dataSpace();
+
+    if (index == hsize_t(-1)) {
+
+      // read whole dataset, has to know its rank and dimensions
+      
+      if (file_dsp.get_simple_extent_type() == H5S_NULL) {
+      
+        // translator saves empty datasets with H5S_NULL dataspace
+        // in this case create 0-sized array
+        std::fill_n(dims, Rank, hsize_t(0));
+        
+      } else {
+       
+        unsigned rank = file_dsp.rank();
+  
+        // check rank
+        if (rank != Rank) throw Hdf5RankMismatch(ERR_LOC, Rank, rank);
+  
+        hsize_t maxdims[Rank];
+        file_dsp.dimensions(dims, maxdims);
+        if (Rank == 1 and maxdims[0] == H5S_UNLIMITED) {
+          // extensible dataset may have reserved extent, only read its logical size
+          hsize_t size = ds.size();
+          if (size < dims[0]) {
+            dims[0] = size;
+            hsize_t start[] = { 0 };
+            file_dsp.select_hyperslab(H5S_SELECT_SET, start, 0, dims, 0);
+          }
+        }
+        mem_dsp = DataSpace::makeSimple(Rank, dims, dims);
+  
+        memType = TypeTraits<Data>::native_type();
+        
+      }
+
+    } else {
+
+      // select single item for dataset
+      file_dsp.select_single(index);
+      mem_dsp = DataSpace::makeScalar();
+
+      // read one element from rank-1 dataset, element of a dataset must
+      // have array type or VLEN type
+
+      hdf5pp::Type etype = ds.type();
+      if (etype.tclass() == H5T_VLEN) {
+
+        // read whole VLEN, Rank must be 1
+        if (Rank != 1) throw Hdf5RankMismatch(ERR_LOC, Rank, 1);
+
+        // Memory type is VLEN
+        memType = VlenType::vlenType(TypeTraits<Data>::native_type());
+        return true;
+      }
+
+      // this will throw if type of data is not an array
+      ArrayType type = ArrayType(etype);
+
+      // check array type rank, get dimensions
+      unsigned rank = type.rank();
+      if (rank != Rank) throw Hdf5RankMismatch(ERR_LOC, Rank, rank);
+      type.dimensions(dims);
+
+      memType = TypeCache::arrayType(TypeTraits<Data>::native_type(), Rank, dims);
+    }
+
+    return false;
+  }
+
+  /// template-free implementation of readRagged()
+  static void _readRagged(hdf5pp::DataSet ds, hsize_t begin, hsize_t end, const Type& native_type,
+      VlenArena& arena, std::vector<hvl_t>& rows);
+
+  /// template-free implementation of storeRagged()
+  static void _storeRagged(hdf5pp::DataSet ds, const std::vector<hvl_t>& rows, long begin,
+      const Type& native_type);
+
   /// template-free implementation of storeAt()
   static void _storeAt(hdf5pp::Group group, const std::string& dataset, const void* data, long index,
       const Type& native_type);
@@ -381,7 +787,8 @@ private:
 
   /// template-free implementation of storeArray()
   static void _storeArray(hdf5pp::Group group, const std::string& dataset, const void* data,
-      unsigned rank, const unsigned* shape, const Type& native_type, const Type& stored_type);
+      unsigned rank, const unsigned* shape, const Type& native_type, const Type& stored_type,
+      const PListDataSetCreate& plistDScreate = PListDataSetCreate());
 
 };
 
@@ -0,0 +1,124 @@
+#ifndef HDF5PP_VLENARENA_H
+#define HDF5PP_VLENARENA_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class VlenArena.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <boost/shared_ptr.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5/hdf5.h"
+#include "hdf5pp/PListDataSetXfer.h"
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/// @addtogroup hdf5pp
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Arena allocator for variable-length data.
+ *
+ *  By default HDF5 allocates memory for every variable-length element with
+ *  malloc() and it has to be released with free(). Arena installs its own
+ *  memory manager in a transfer property list (see xferPlist()), reads which
+ *  use that property list place variable-length data into large blocks of
+ *  memory which belong to current region. Individual allocations are never
+ *  released, whole region is released when the last reference to it
+ *  disappears. Objects which point to variable-length data should keep the
+ *  region alive, e.g. with shared pointer returned from share().
+ *
+ *  New region is started by newRegion(), or automatically by maybeNewRegion()
+ *  when current region grows above a limit. Typically one arena is used by one
+ *  reader for a sequence of reads, Utils::readNdarray() with arena argument
+ *  does that.
+ *
+ *  Arena objects have reference semantics, copies share the same state.
+ *  Arena is not thread-safe, it should be used by one thread only.
+ *
+ *  This software was developed for the LCLS project.  If you use all or
+ *  part of it, please give an appropriate acknowledgment.
+ *
+ *  @see Utils::readNdarray
+ *
+ *  @version $Id$
+ */
+
+class VlenArena  {
+public:
+
+  /**
+   *  @brief Make new arena.
+   *
+   *  @param[in] blockSize    Size of memory blocks, larger allocations get separate blocks.
+   *  @param[in] regionLimit  Region size above which maybeNewRegion() starts new region.
+   *
+   *  @throw hdf5pp::Exception
+   */
+  explicit VlenArena(size_t blockSize = 1024*1024, size_t regionLimit = 16*1024*1024);
+
+  // Destructor
+  ~VlenArena() ;
+
+  /// Get transfer property list which makes HDF5 allocate VLEN data from this arena.
+  const PListDataSetXfer& xferPlist() const;
+
+  /// Allocate memory from current region, memory is aligned for any type.
+  void* allocate(size_t size);
+
+  /// Get shared pointer which points to data and keeps current region alive.
+  template <typename T>
+  boost::shared_ptr<T> share(T* data) const { return boost::shared_ptr<T>(_region(), data); }
+
+  /// Start new region, current region is released when not referenced any more.
+  void newRegion();
+
+  /// Start new region if current region size is above the limit.
+  void maybeNewRegion();
+
+  /// Get number of bytes allocated in current region.
+  size_t regionSize() const;
+
+  /// Get number of regions made so far.
+  unsigned long regions() const;
+
+protected:
+
+private:
+
+  struct Impl;
+
+  // shared pointer to current region
+  boost::shared_ptr<void> _region() const;
+
+  // Data members
+  boost::shared_ptr<Impl> m_impl;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_VLENARENA_H
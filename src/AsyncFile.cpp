@@ -0,0 +1,355 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Classes AsyncToken, AsyncFile and AsyncDataSet...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/AsyncFile.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <deque>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/DataSpace.h"
+#include "hdf5pp/Exceptions.h"
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.AsyncFile";
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// state of one request shared between token and I/O thread
+struct AsyncToken::State {
+  State() : done(false) {}
+
+  void finish(const std::string& err) {
+    boost::mutex::scoped_lock lock(mutex);
+    error = err;
+    done = true;
+    cond.notify_all();
+  }
+
+  boost::mutex mutex;
+  boost::condition_variable cond;
+  bool done;
+  std::string error;
+};
+
+// Returns true if request has been executed
+bool
+AsyncToken::done() const
+{
+  if (not m_state) return true;
+  boost::mutex::scoped_lock lock(m_state->mutex);
+  return m_state->done;
+}
+
+// Wait until request is executed.
+void
+AsyncToken::wait() const
+{
+  if (not m_state) return;
+  boost::mutex::scoped_lock lock(m_state->mutex);
+  while (not m_state->done) m_state->cond.wait(lock);
+  if (not m_state->error.empty()) throw Exception(ERR_LOC, "AsyncToken", m_state->error);
+}
+
+// One queued store request
+struct AsyncFile::Request {
+  DataSet ds;                           ///< Dataset to write to
+  Type type;                            ///< In-memory type
+  bool append;                          ///< If true then append to rank-1 dataset
+  std::vector<hsize_t> offset;          ///< Hyperslab offset (not used for append)
+  std::vector<hsize_t> dims;            ///< Data dimensions
+  boost::shared_ptr<const void> data;   ///< Shared data
+  std::vector<char> copy;               ///< Owned copy of the data
+  size_t bytes;                         ///< Data size
+  AsyncToken token;                     ///< Completion token
+
+  // execute request, runs in I/O thread
+  void execute();
+};
+
+void
+AsyncFile::Request::execute()
+{
+  const void* buf = copy.empty() ? data.get() : static_cast<const void*>(&copy.front());
+  hsize_t start[H5S_MAX_RANK];
+  if (append) {
+    hsize_t size = ds.size();
+    ds.resize(size + dims[0]);
+    start[0] = size;
+  } else {
+    std::copy(offset.begin(), offset.end(), start);
+  }
+  DataSpace fileDsp = ds.dataSpace();
+  fileDsp.select_hyperslab(H5S_SELECT_SET, start, 0, &dims.front(), 0);
+  DataSpace memDsp = DataSpace::makeSimple(dims.size(), &dims.front(), &dims.front());
+  ds.store(memDsp, fileDsp, buf, type);
+}
+
+// Implementation of the queue, shared by AsyncFile and AsyncDataSet objects
+struct AsyncFile::Impl {
+
+  typedef boost::shared_ptr<Request> RequestPtr;
+
+  Impl(const File& file, size_t maxBytes);
+  ~Impl();
+
+  // add request to a queue, blocks if queue is full
+  void queue(const RequestPtr& req);
+
+  // wait until queue is empty
+  void drain();
+
+  // I/O thread main loop
+  void run();
+
+  File m_file;                      ///< File is kept open while requests are pending
+  size_t m_maxBytes;                ///< Limit on queued data size
+  size_t m_queuedBytes;             ///< Current size of queued data
+  std::deque<RequestPtr> m_queue;   ///< Queued requests
+  bool m_busy;                      ///< True while I/O thread executes request
+  bool m_stop;                      ///< Set to stop I/O thread
+  std::string m_error;              ///< First error since last drain()
+  boost::mutex m_mutex;             ///< Protects queue state
+  boost::condition_variable m_cond; ///< Signals queue state change
+  boost::mutex m_h5mutex;           ///< Held while this package calls HDF5 in I/O thread
+  boost::thread m_thread;           ///< I/O thread, must be last
+};
+
+AsyncFile::Impl::Impl(const File& file, size_t maxBytes)
+  : m_file(file)
+  , m_maxBytes(maxBytes)
+  , m_queuedBytes(0)
+  , m_queue()
+  , m_busy(false)
+  , m_stop(false)
+  , m_error()
+  , m_mutex()
+  , m_cond()
+  , m_h5mutex()
+  , m_thread(boost::bind(&Impl::run, this))
+{
+#if H5_VERSION_GE(1,8,16)
+  hbool_t threadsafe = 0;
+  if (H5is_library_threadsafe(&threadsafe) >= 0 and not threadsafe) {
+    MsgLog(logger, warning, "AsyncFile: HDF5 library is not thread-safe, other threads must not use "
+           "HDF5 while requests are pending");
+  }
+#endif
+}
+
+AsyncFile::Impl::~Impl()
+{
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+  if (not m_error.empty()) {
+    MsgLog(logger, error, "AsyncFile: request failed: " << m_error);
+  }
+}
+
+void
+AsyncFile::Impl::queue(const RequestPtr& req)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  // back-pressure, single request larger than limit is still accepted when queue is empty
+  while (not m_queue.empty() and m_queuedBytes + req->bytes > m_maxBytes) m_cond.wait(lock);
+  m_queue.push_back(req);
+  m_queuedBytes += req->bytes;
+  m_cond.notify_all();
+}
+
+void
+AsyncFile::Impl::drain()
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  while (not m_queue.empty() or m_busy) m_cond.wait(lock);
+  if (not m_error.empty()) {
+    std::string error;
+    error.swap(m_error);
+    throw Exception(ERR_LOC, "AsyncFile", error);
+  }
+}
+
+void
+AsyncFile::Impl::run()
+{
+  while (true) {
+
+    RequestPtr req;
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+      while (m_queue.empty() and not m_stop) m_cond.wait(lock);
+      if (m_queue.empty()) return;
+      req = m_queue.front();
+      m_queue.pop_front();
+      m_busy = true;
+    }
+
+    std::string error;
+    AsyncToken token = req->token;
+    size_t bytes = req->bytes;
+    {
+      boost::mutex::scoped_lock h5lock(m_h5mutex);
+      try {
+        req->execute();
+      } catch (const std::exception& ex) {
+        error = ex.what();
+      }
+      // HDF5 objects in request may be released here
+      req.reset();
+    }
+    token.m_state->finish(error);
+
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+      if (not error.empty() and m_error.empty()) m_error = error;
+      m_queuedBytes -= bytes;
+      m_busy = false;
+      m_cond.notify_all();
+    }
+  }
+}
+
+//----------------
+// Constructors --
+//----------------
+AsyncFile::AsyncFile(const File& file, size_t maxBytes)
+  : m_impl(boost::make_shared<Impl>(file, maxBytes))
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+AsyncFile::~AsyncFile()
+{
+}
+
+// Make asynchronous interface for a dataset.
+AsyncDataSet
+AsyncFile::dataSet(const DataSet& ds, const Type& native_type)
+{
+  // dataset parameters are determined in this thread, serialize with I/O thread
+  boost::mutex::scoped_lock h5lock(m_impl->m_h5mutex);
+  return AsyncDataSet(m_impl, ds, native_type);
+}
+
+// Wait until all queued requests are executed.
+void
+AsyncFile::drain()
+{
+  m_impl->drain();
+}
+
+// Get total size of the data in the queue
+size_t
+AsyncFile::queuedBytes() const
+{
+  boost::mutex::scoped_lock lock(m_impl->m_mutex);
+  return m_impl->m_queuedBytes;
+}
+
+// Constructor
+AsyncDataSet::AsyncDataSet(const boost::shared_ptr<AsyncFile::Impl>& file, const DataSet& ds, const Type& native_type)
+  : m_file(file)
+  , m_ds(ds)
+  , m_type(native_type)
+  , m_typeSize(native_type.size())
+  , m_rank(m_ds.dataSpace().rank())
+  , m_last()
+{
+}
+
+// Append records to the end of rank-1 dataset.
+AsyncToken
+AsyncDataSet::append(const boost::shared_ptr<const void>& data, hsize_t count)
+{
+  return queue(data, 0, true, 0, &count);
+}
+
+// Append records to the end of rank-1 dataset, data are copied.
+AsyncToken
+AsyncDataSet::appendCopy(const void* data, hsize_t count)
+{
+  return queue(boost::shared_ptr<const void>(), data, true, 0, &count);
+}
+
+// Store array in a hyperslab of a dataset.
+AsyncToken
+AsyncDataSet::store(const boost::shared_ptr<const void>& data, const hsize_t offset[], const hsize_t dims[])
+{
+  return queue(data, 0, false, offset, dims);
+}
+
+// Store array in a hyperslab of a dataset, data are copied.
+AsyncToken
+AsyncDataSet::storeCopy(const void* data, const hsize_t offset[], const hsize_t dims[])
+{
+  return queue(boost::shared_ptr<const void>(), data, false, offset, dims);
+}
+
+// make request and queue it
+AsyncToken
+AsyncDataSet::queue(const boost::shared_ptr<const void>& data, const void* copy, bool append,
+    const hsize_t offset[], const hsize_t dims[])
+{
+  unsigned rank = append ? 1 : m_rank;
+  if (append and m_rank != 1) throw Hdf5RankMismatch(ERR_LOC, 1, m_rank);
+
+  boost::shared_ptr<AsyncFile::Request> req = boost::make_shared<AsyncFile::Request>();
+  req->ds = m_ds;
+  req->type = m_type;
+  req->append = append;
+  if (offset) req->offset.assign(offset, offset+rank);
+  req->dims.assign(dims, dims+rank);
+  req->bytes = m_typeSize;
+  for (unsigned i = 0; i != rank; ++ i) req->bytes *= dims[i];
+  if (copy) {
+    const char* p = static_cast<const char*>(copy);
+    req->copy.assign(p, p+req->bytes);
+  } else {
+    req->data = data;
+  }
+  req->token.m_state = boost::make_shared<AsyncToken::State>();
+
+  m_last = req->token;
+  m_file->queue(req);
+  return m_last;
+}
+
+} // namespace hdf5pp
@@ -0,0 +1,667 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class Catalog...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/Catalog.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <boost/functional/hash.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Exceptions.h"
+#include "hdf5pp/File.h"
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.Catalog";
+
+  // binary format identification
+  const char magic[] = "hdf5pp.Catalog";
+  const uint32_t formatVersion = 2;
+  const uint32_t byteOrderMark = 0x01020304;
+
+  // write plain value
+  template <typename T>
+  void writePod(std::ostream& out, const T& value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof value);
+  }
+
+  // write vector of plain values
+  template <typename T>
+  void writeVector(std::ostream& out, const std::vector<T>& vec)
+  {
+    writePod(out, uint64_t(vec.size()));
+    if (not vec.empty()) out.write(reinterpret_cast<const char*>(&vec.front()), vec.size()*sizeof(T));
+  }
+
+  // write string
+  void writeString(std::ostream& out, const std::string& str)
+  {
+    writePod(out, uint32_t(str.size()));
+    out.write(str.data(), str.size());
+  }
+
+  // input stream which knows how many bytes are left in it, sizes read
+  // from corrupted data are checked against that before allocating memory
+  class Input {
+  public:
+
+    Input(std::istream& in) : m_in(in), m_left(std::numeric_limits<uint64_t>::max())
+    {
+      std::istream::pos_type pos = in.tellg();
+      if (pos != std::istream::pos_type(-1)) {
+        in.seekg(0, std::ios::end);
+        std::istream::pos_type end = in.tellg();
+        in.clear();
+        in.seekg(pos);
+        if (end != std::istream::pos_type(-1) and end >= pos) m_left = end - pos;
+      }
+      in.clear();
+    }
+
+    uint64_t left() const { return m_left; }
+
+    void read(void* buf, uint64_t size)
+    {
+      if (size > m_left) throw hdf5pp::Exception(ERR_LOC, "Catalog", "catalog data is truncated");
+      m_in.read(static_cast<char*>(buf), size);
+      if (not m_in) throw hdf5pp::Exception(ERR_LOC, "Catalog", "catalog data is truncated");
+      m_left -= size;
+    }
+
+    template <typename T>
+    void readPod(T& value) { read(&value, sizeof value); }
+
+    template <typename T>
+    void readVector(std::vector<T>& vec)
+    {
+      uint64_t size = 0;
+      readPod(size);
+      if (size > m_left / sizeof(T)) throw hdf5pp::Exception(ERR_LOC, "Catalog", "catalog data is truncated");
+      vec.resize(size);
+      if (size) read(&vec.front(), size*sizeof(T));
+    }
+
+    void readString(std::string& str)
+    {
+      uint32_t size = 0;
+      readPod(size);
+      if (size > m_left) throw hdf5pp::Exception(ERR_LOC, "Catalog", "catalog data is truncated");
+      str.resize(size);
+      if (size) read(&str[0], size);
+    }
+
+  private:
+    std::istream& m_in;
+    uint64_t m_left;
+  };
+
+  // smallest size of serialized object, object with empty path
+  const uint64_t minObjectSize = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(int32_t)
+      + sizeof(hdf5pp::PathCache::Token) + sizeof(int32_t) + sizeof(uint32_t) + 3*sizeof(uint8_t)
+      + 2*sizeof(uint32_t) + sizeof(uint64_t);
+
+  void corrupted(const std::string& what)
+  {
+    throw hdf5pp::Exception(ERR_LOC, "Catalog", "catalog data is corrupted: " + what);
+  }
+
+  // order objects by file and path
+  struct ObjectLess {
+    bool operator()(const hdf5pp::Catalog::Object& lhs, const hdf5pp::Catalog::Object& rhs) const {
+      if (lhs.file != rhs.file) return lhs.file < rhs.file;
+      return lhs.path < rhs.path;
+    }
+  };
+
+  // write all data to file descriptor
+  bool writeAll(int fd, const std::string& data)
+  {
+    const char* p = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+      ssize_t n = ::write(fd, p, left);
+      if (n < 0 and errno == EINTR) continue;
+      if (n <= 0) return false;
+      p += n;
+      left -= n;
+    }
+    return true;
+  }
+
+  // read all data from file descriptor until end of file
+  bool readAll(int fd, std::string& data)
+  {
+    char buf[65536];
+    while (true) {
+      ssize_t n = ::read(fd, buf, sizeof buf);
+      if (n < 0 and errno == EINTR) continue;
+      if (n < 0) return false;
+      if (n == 0) return true;
+      data.append(buf, n);
+    }
+  }
+
+  // child process running scan of one file
+  struct Worker {
+    pid_t pid;
+    int fd;
+    std::string path;
+  };
+
+  // scan one file in a child process, returns serialized catalog
+  std::string scanChild(const std::string& path)
+  {
+    hdf5pp::File file = hdf5pp::File::open(path, hdf5pp::File::Read);
+    std::ostringstream str;
+    hdf5pp::Catalog::scan(file).write(str);
+    return str.str();
+  }
+
+  // wait for child process and read its catalog, sets error message on failure
+  hdf5pp::Catalog finishWorker(const Worker& w, std::string& errmsg)
+  {
+    std::string data;
+    bool ok = readAll(w.fd, data);
+    close(w.fd);
+    int status = 0;
+    while (waitpid(w.pid, &status, 0) < 0 and errno == EINTR) {}
+    if (ok and WIFEXITED(status) and WEXITSTATUS(status) == 0) {
+      try {
+        std::istringstream str(data);
+        return hdf5pp::Catalog::read(str);
+      } catch (const std::exception& ex) {
+        MsgLog(logger, error, "Catalog::scan: " << ex.what());
+      }
+    }
+    if (errmsg.empty()) errmsg = "failed to scan file " + w.path;
+    return hdf5pp::Catalog();
+  }
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+struct Catalog::Data {
+
+  // hash of a path in a file
+  static size_t hash(uint32_t file, const std::string& path)
+  {
+    size_t seed = boost::hash<std::string>()(path);
+    boost::hash_combine(seed, file);
+    return seed;
+  }
+
+  // build hash index, open addressing with linear probing, table
+  // size is power of 2 and at least twice the number of objects
+  void buildIndex()
+  {
+    size_t size = 16;
+    while (size < 2*objects.size()) size *= 2;
+    table.assign(size, 0);
+    for (size_t i = 0; i != objects.size(); ++ i) {
+      size_t pos = hash(objects[i].file, objects[i].path) & (size - 1);
+      while (table[pos] != 0) pos = (pos + 1) & (size - 1);
+      table[pos] = i + 1;
+    }
+  }
+
+  // add all objects of a file
+  void scanFile(hid_t fid);
+
+  // add dataset details to the last object
+  void addDataset(hid_t ds);
+
+  // H5Ovisit callback, adds one object
+#if H5_VERSION_GE(1,12,0)
+  static herr_t visit(hid_t loc, const char* name, const H5O_info2_t* info, void* op_data);
+#else
+  static herr_t visit(hid_t loc, const char* name, const H5O_info_t* info, void* op_data);
+#endif
+
+  std::vector<std::string> files;   ///< File names
+  std::vector<Object> objects;      ///< All objects sorted by file and path
+  std::vector<hsize_t> dims;        ///< Pool of dimensions
+  std::vector<H5Z_filter_t> filters;  ///< Pool of filters
+  std::vector<uint32_t> table;      ///< Hash index, object index plus one, zero for empty slots
+  std::string error;                ///< Error message from visit callback
+};
+
+void
+Catalog::Data::scanFile(hid_t fid)
+{
+  ssize_t size = H5Fget_name(fid, 0, 0);
+  if (size < 0) throw Hdf5CallException(ERR_LOC, "H5Fget_name");
+  std::vector<char> name(size+1);
+  H5Fget_name(fid, &name.front(), size+1);
+  files.push_back(&name.front());
+
+  size_t first = objects.size();
+  error.clear();
+#if H5_VERSION_GE(1,12,0)
+  herr_t stat = H5Ovisit3(fid, H5_INDEX_NAME, H5_ITER_INC, &Data::visit, this, H5O_INFO_BASIC);
+  const char* func = "H5Ovisit3";
+#elif H5_VERSION_GE(1,10,3)
+  herr_t stat = H5Ovisit2(fid, H5_INDEX_NAME, H5_ITER_INC, &Data::visit, this, H5O_INFO_BASIC);
+  const char* func = "H5Ovisit2";
+#else
+  herr_t stat = H5Ovisit(fid, H5_INDEX_NAME, H5_ITER_INC, &Data::visit, this);
+  const char* func = "H5Ovisit";
+#endif
+  if (not error.empty()) throw Exception(ERR_LOC, "Catalog", error);
+  if (stat < 0) throw Hdf5CallException(ERR_LOC, func);
+
+  std::sort(objects.begin() + first, objects.end(), ObjectLess());
+}
+
+herr_t
+#if H5_VERSION_GE(1,12,0)
+Catalog::Data::visit(hid_t loc, const char* name, const H5O_info2_t* info, void* op_data)
+#else
+Catalog::Data::visit(hid_t loc, const char* name, const H5O_info_t* info, void* op_data)
+#endif
+{
+  Data& data = *static_cast<Data*>(op_data);
+
+  Object obj;
+  obj.path = std::strcmp(name, ".") == 0 ? std::string("/") : "/" + std::string(name);
+  obj.file = data.files.size() - 1;
+  obj.type = info->type;
+#if H5_VERSION_GE(1,12,0)
+  obj.token = info->token;
+#else
+  obj.token = info->addr;
+#endif
+  obj.typeClass = H5T_NO_CLASS;
+  obj.typeSize = 0;
+  obj.rank = 0;
+  obj.nFilters = 0;
+  obj.chunked = false;
+  obj.dimsIdx = data.dims.size();
+  obj.filtersIdx = data.filters.size();
+  obj.storageSize = 0;
+  data.objects.push_back(obj);
+
+  if (info->type == H5O_TYPE_DATASET) {
+    // exceptions cannot propagate through HDF5
+    hid_t ds = H5Dopen2(loc, name, H5P_DEFAULT);
+    if (ds < 0) {
+      data.error = "H5Dopen2 failed for " + obj.path;
+      return -1;
+    }
+    try {
+      data.addDataset(ds);
+    } catch (const std::exception& ex) {
+      data.error = ex.what();
+    }
+    H5Dclose(ds);
+    if (not data.error.empty()) return -1;
+  }
+  return 0;
+}
+
+void
+Catalog::Data::addDataset(hid_t ds)
+{
+  Object& obj = objects.back();
+
+  hid_t type = H5Dget_type(ds);
+  if (type < 0) throw Hdf5CallException(ERR_LOC, "H5Dget_type");
+  obj.typeClass = H5Tget_class(type);
+  obj.typeSize = H5Tget_size(type);
+  H5Tclose(type);
+
+  hid_t space = H5Dget_space(ds);
+  if (space < 0) throw Hdf5CallException(ERR_LOC, "H5Dget_space");
+  int rank = H5Sget_simple_extent_ndims(space);
+  hsize_t sdims[H5S_MAX_RANK];
+  if (rank > 0) H5Sget_simple_extent_dims(space, sdims, 0);
+  H5Sclose(space);
+  if (rank < 0) throw Hdf5CallException(ERR_LOC, "H5Sget_simple_extent_ndims");
+  obj.rank = rank;
+  obj.dimsIdx = dims.size();
+  dims.insert(dims.end(), sdims, sdims+rank);
+
+  hid_t plist = H5Dget_create_plist(ds);
+  if (plist < 0) throw Hdf5CallException(ERR_LOC, "H5Dget_create_plist");
+  obj.chunked = H5Pget_layout(plist) == H5D_CHUNKED;
+  if (obj.chunked) {
+    hsize_t cdims[H5S_MAX_RANK];
+    H5Pget_chunk(plist, rank, cdims);
+    dims.insert(dims.end(), cdims, cdims+rank);
+  }
+  int nfilters = H5Pget_nfilters(plist);
+  obj.filtersIdx = filters.size();
+  for (int i = 0; i < nfilters; ++ i) {
+    unsigned flags;
+    size_t nelem = 0;
+    H5Z_filter_t filter = H5Pget_filter2(plist, i, &flags, &nelem, 0, 0, 0, 0);
+    if (filter >= 0) filters.push_back(filter);
+  }
+  obj.nFilters = filters.size() - obj.filtersIdx;
+  H5Pclose(plist);
+
+  obj.storageSize = H5Dget_storage_size(ds);
+}
+
+//----------------
+// Constructors --
+//----------------
+Catalog::Catalog()
+  : m_data(boost::make_shared<Data>())
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+Catalog::~Catalog ()
+{
+}
+
+// Scan all objects in a file.
+Catalog
+Catalog::scan(const File& file)
+{
+  boost::shared_ptr<Data> data = boost::make_shared<Data>();
+  data->scanFile(file.id());
+  data->buildIndex();
+  MsgLog(logger, debug, "Catalog::scan: file=" << data->files.front() << " objects=" << data->objects.size());
+  return Catalog(data);
+}
+
+// Scan many files concurrently and merge the catalogs.
+Catalog
+Catalog::scan(const std::vector<std::string>& paths, unsigned nWorkers)
+{
+  if (nWorkers == 0) nWorkers = boost::thread::hardware_concurrency();
+
+  std::vector<Catalog> catalogs;
+  catalogs.reserve(paths.size());
+
+  if (nWorkers <= 1 or paths.size() <= 1) {
+    for (std::vector<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++ it) {
+      catalogs.push_back(scan(File::open(*it, File::Read)));
+    }
+    return merge(catalogs);
+  }
+
+  // children are started in order and their output is read in the same order,
+  // children which finish early block on full pipe until they are read
+  std::deque<Worker> running;
+  std::string errmsg;
+  for (size_t i = 0; i != paths.size() and errmsg.empty(); ++ i) {
+
+    if (running.size() == nWorkers) {
+      catalogs.push_back(::finishWorker(running.front(), errmsg));
+      running.pop_front();
+      if (not errmsg.empty()) break;
+    }
+
+    int fds[2];
+    if (pipe(fds) < 0) {
+      errmsg = "pipe() failed: " + std::string(std::strerror(errno));
+      break;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+      errmsg = "fork() failed: " + std::string(std::strerror(errno));
+      close(fds[0]);
+      close(fds[1]);
+      break;
+    }
+    if (pid == 0) {
+      // child, never returns, _exit() skips flushing files opened by parent
+      close(fds[0]);
+      int status = 1;
+      try {
+        if (::writeAll(fds[1], ::scanChild(paths[i]))) status = 0;
+      } catch (const std::exception& ex) {
+        MsgLog(logger, error, "Catalog::scan: " << ex.what());
+      }
+      _exit(status);
+    }
+    close(fds[1]);
+    Worker w = { pid, fds[0], paths[i] };
+    running.push_back(w);
+  }
+
+  // on errors still need to collect all children
+  while (not running.empty()) {
+    catalogs.push_back(::finishWorker(running.front(), errmsg));
+    running.pop_front();
+  }
+  if (not errmsg.empty()) throw Exception(ERR_LOC, "Catalog", errmsg);
+
+  return merge(catalogs);
+}
+
+// Merge catalogs.
+Catalog
+Catalog::merge(const std::vector<Catalog>& catalogs)
+{
+  boost::shared_ptr<Data> data = boost::make_shared<Data>();
+  for (std::vector<Catalog>::const_iterator it = catalogs.begin(); it != catalogs.end(); ++ it) {
+    const Data& src = *it->m_data;
+    uint32_t fileOffset = data->files.size();
+    uint32_t dimsOffset = data->dims.size();
+    uint32_t filtersOffset = data->filters.size();
+    data->files.insert(data->files.end(), src.files.begin(), src.files.end());
+    data->dims.insert(data->dims.end(), src.dims.begin(), src.dims.end());
+    data->filters.insert(data->filters.end(), src.filters.begin(), src.filters.end());
+    for (std::vector<Object>::const_iterator oit = src.objects.begin(); oit != src.objects.end(); ++ oit) {
+      data->objects.push_back(*oit);
+      Object& obj = data->objects.back();
+      obj.file += fileOffset;
+      obj.dimsIdx += dimsOffset;
+      obj.filtersIdx += filtersOffset;
+    }
+  }
+  data->buildIndex();
+  return Catalog(data);
+}
+
+// Read catalog written by write().
+Catalog
+Catalog::read(std::istream& in)
+{
+  Input input(in);
+
+  char hdr[sizeof magic];
+  uint32_t version = 0, bom = 0;
+  if (input.left() < sizeof hdr + sizeof version + sizeof bom) {
+    throw Exception(ERR_LOC, "Catalog", "stream does not contain catalog data");
+  }
+  input.read(hdr, sizeof hdr);
+  input.readPod(version);
+  input.readPod(bom);
+  if (std::memcmp(hdr, magic, sizeof magic) != 0) {
+    throw Exception(ERR_LOC, "Catalog", "stream does not contain catalog data");
+  }
+  if (version != formatVersion or bom != byteOrderMark) {
+    throw Exception(ERR_LOC, "Catalog", "catalog data has unsupported format or byte order");
+  }
+
+  boost::shared_ptr<Data> data = boost::make_shared<Data>();
+
+  uint32_t nfiles = 0;
+  input.readPod(nfiles);
+  if (nfiles > input.left() / sizeof(uint32_t)) corrupted("too many files");
+  data->files.resize(nfiles);
+  for (uint32_t i = 0; i != nfiles; ++ i) input.readString(data->files[i]);
+
+  uint64_t nobjects = 0;
+  input.readPod(nobjects);
+  if (nobjects > input.left() / minObjectSize) corrupted("too many objects");
+  data->objects.resize(nobjects);
+  for (uint64_t i = 0; i != nobjects; ++ i) {
+    Object& obj = data->objects[i];
+    int32_t type = 0, typeClass = 0;
+    uint8_t chunked = 0;
+    input.readString(obj.path);
+    input.readPod(obj.file);
+    input.readPod(type);
+    input.readPod(obj.token);
+    input.readPod(typeClass);
+    input.readPod(obj.typeSize);
+    input.readPod(obj.rank);
+    input.readPod(obj.nFilters);
+    input.readPod(chunked);
+    input.readPod(obj.dimsIdx);
+    input.readPod(obj.filtersIdx);
+    input.readPod(obj.storageSize);
+    if (obj.file >= nfiles) corrupted("file index out of range");
+    if (type < H5O_TYPE_UNKNOWN or type >= H5O_TYPE_NTYPES) corrupted("unknown object type");
+    if (typeClass < H5T_NO_CLASS or typeClass >= H5T_NCLASSES) corrupted("unknown data type class");
+    if (obj.rank > H5S_MAX_RANK) corrupted("rank is too large");
+    if (chunked > 1) corrupted("bad chunked flag");
+    obj.type = H5O_type_t(type);
+    obj.typeClass = H5T_class_t(typeClass);
+    obj.chunked = chunked;
+  }
+  input.readVector(data->dims);
+  input.readVector(data->filters);
+
+  // pool indices can only be checked after pools are read
+  for (std::vector<Object>::const_iterator it = data->objects.begin(); it != data->objects.end(); ++ it) {
+    if (uint64_t(it->dimsIdx) + it->rank * (it->chunked ? 2 : 1) > data->dims.size()) {
+      corrupted("dimensions index out of range");
+    }
+    if (uint64_t(it->filtersIdx) + it->nFilters > data->filters.size()) {
+      corrupted("filters index out of range");
+    }
+  }
+
+  data->buildIndex();
+  return Catalog(data);
+}
+
+// Write catalog to a stream.
+void
+Catalog::write(std::ostream& out) const
+{
+  const Data& data = *m_data;
+
+  out.write(magic, sizeof magic);
+  writePod(out, formatVersion);
+  writePod(out, byteOrderMark);
+
+  writePod(out, uint32_t(data.files.size()));
+  for (std::vector<std::string>::const_iterator it = data.files.begin(); it != data.files.end(); ++ it) {
+    writeString(out, *it);
+  }
+
+  writePod(out, uint64_t(data.objects.size()));
+  for (std::vector<Object>::const_iterator it = data.objects.begin(); it != data.objects.end(); ++ it) {
+    writeString(out, it->path);
+    writePod(out, it->file);
+    writePod(out, int32_t(it->type));
+    writePod(out, it->token);
+    writePod(out, int32_t(it->typeClass));
+    writePod(out, it->typeSize);
+    writePod(out, it->rank);
+    writePod(out, it->nFilters);
+    writePod(out, uint8_t(it->chunked));
+    writePod(out, it->dimsIdx);
+    writePod(out, it->filtersIdx);
+    writePod(out, it->storageSize);
+  }
+  writeVector(out, data.dims);
+  writeVector(out, data.filters);
+}
+
+// Get names of the scanned files
+const std::vector<std::string>&
+Catalog::files() const
+{
+  return m_data->files;
+}
+
+// Get number of objects
+size_t
+Catalog::size() const
+{
+  return m_data->objects.size();
+}
+
+// Get object by index
+const Catalog::Object&
+Catalog::object(size_t i) const
+{
+  return m_data->objects[i];
+}
+
+// Find object by path
+const Catalog::Object*
+Catalog::find(const std::string& path, uint32_t file) const
+{
+  const Data& data = *m_data;
+  if (data.table.empty()) return 0;
+  size_t mask = data.table.size() - 1;
+  for (size_t pos = Data::hash(file, path) & mask; data.table[pos] != 0; pos = (pos + 1) & mask) {
+    const Object& obj = data.objects[data.table[pos] - 1];
+    if (obj.file == file and obj.path == path) return &obj;
+  }
+  return 0;
+}
+
+// Get dataspace dimensions of a dataset
+std::vector<hsize_t>
+Catalog::dims(const Object& obj) const
+{
+  std::vector<hsize_t>::const_iterator begin = m_data->dims.begin() + obj.dimsIdx;
+  return std::vector<hsize_t>(begin, begin + obj.rank);
+}
+
+// Get chunk dimensions of a dataset
+std::vector<hsize_t>
+Catalog::chunkDims(const Object& obj) const
+{
+  if (not obj.chunked) return std::vector<hsize_t>();
+  std::vector<hsize_t>::const_iterator begin = m_data->dims.begin() + obj.dimsIdx + obj.rank;
+  return std::vector<hsize_t>(begin, begin + obj.rank);
+}
+
+// Get filters of a dataset
+std::vector<H5Z_filter_t>
+Catalog::filters(const Object& obj) const
+{
+  std::vector<H5Z_filter_t>::const_iterator begin = m_data->filters.begin() + obj.filtersIdx;
+  return std::vector<H5Z_filter_t>(begin, begin + obj.nFilters);
+}
+
+} // namespace hdf5pp
@@ -0,0 +1,336 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class ChunkReader...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/ChunkReader.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <cstring>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/scoped_ptr.hpp>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/DataSpace.h"
+#include "hdf5pp/FilterPipeline.h"
+#include "MsgLogger/MsgLogger.h"
+#include "WorkerPool.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.ChunkReader";
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Implementation is shared between all copies of the reader.
+struct ChunkReader::Impl {
+
+  // One chunk on its way from a file
+  struct Job {
+    std::vector<hsize_t> offset;  ///< Chunk offset
+    std::vector<char> data;       ///< Raw chunk data
+    uint32_t mask;                ///< Filter mask
+  };
+  typedef boost::shared_ptr<Job> JobPtr;
+
+  Impl(const DataSet& ds, unsigned nThreads, unsigned maxPending);
+
+  bool supported(const Type& native_type) const;
+  void read(char* data, const Type& native_type);
+
+  // read hyperslab of a dataset with H5Dread into destination array
+  void readRegion(char* data, const hsize_t offset[], const hsize_t count[], const Type& native_type);
+
+  // wait until number of chunks in flight drops to given number
+  void wait(size_t maxPending);
+
+  // runs in worker thread
+  void decode(const JobPtr& job, char* data);
+
+  DataSet m_ds;                  ///< Dataset to read from
+  Type m_type;                   ///< Dataset type
+  FilterPipeline m_pipeline;     ///< Dataset filters
+  unsigned m_rank;               ///< Dataset rank
+  std::vector<hsize_t> m_dims;   ///< Dataset dimensions (logical size for rank-1)
+  hsize_t m_size;                ///< Total number of elements
+  std::vector<hsize_t> m_chunk;  ///< Chunk dimensions
+  size_t m_elemSize;             ///< Size of one element
+  size_t m_chunkBytes;           ///< Size of unfiltered chunk
+  size_t m_maxPending;           ///< Max. number of chunks in flight
+  size_t m_inFlight;             ///< Number of chunks in flight
+  std::string m_error;           ///< First error message from workers
+  boost::mutex m_mutex;          ///< Protects state shared with workers
+  boost::condition_variable m_cond;
+  boost::scoped_ptr<WorkerPool> m_pool; ///< Only exists if parallel read is possible, must be last
+};
+
+ChunkReader::Impl::Impl(const DataSet& ds, unsigned nThreads, unsigned maxPending)
+  : m_ds(ds)
+  , m_type(m_ds.type())
+  , m_pipeline()
+  , m_rank(0)
+  , m_dims()
+  , m_size(0)
+  , m_chunk()
+  , m_elemSize(0)
+  , m_chunkBytes(0)
+  , m_maxPending(maxPending)
+  , m_inFlight(0)
+  , m_error()
+  , m_mutex()
+  , m_cond()
+  , m_pool()
+{
+  DataSpace dsp = m_ds.dataSpace();
+  H5S_class_t dspClass = dsp.get_simple_extent_type();
+  if (dspClass == H5S_SCALAR) m_size = 1;
+  if (dspClass != H5S_SIMPLE) return;
+
+  m_rank = dsp.rank();
+  m_dims.resize(m_rank);
+  std::vector<hsize_t> maxdims(m_rank);
+  dsp.dimensions(&m_dims.front(), &maxdims.front());
+  if (m_rank == 1 and maxdims[0] == H5S_UNLIMITED) {
+    // extensible dataset may have reserved extent, only read its logical size
+    m_dims[0] = std::min(m_dims[0], m_ds.size());
+  }
+  m_size = 1;
+  for (unsigned i = 0; i != m_rank; ++ i) m_size *= m_dims[i];
+
+#if H5_VERSION_GE(1,10,0)
+  hid_t plist = H5Dget_create_plist(m_ds.id());
+  if (plist < 0) throw Hdf5CallException( ERR_LOC, "H5Dget_create_plist" ) ;
+  H5D_layout_t layout = H5Pget_layout(plist);
+  H5Pclose(plist);
+  if (layout != H5D_CHUNKED) return;
+
+  // chunks which are still in chunk cache are not visible to raw chunk reads
+  if (H5Dflush(m_ds.id()) < 0) throw Hdf5CallException( ERR_LOC, "H5Dflush" ) ;
+  H5D_space_status_t status;
+  if (H5Dget_space_status(m_ds.id(), &status) < 0) throw Hdf5CallException( ERR_LOC, "H5Dget_space_status" ) ;
+  if (status == H5D_SPACE_STATUS_NOT_ALLOCATED) return;
+
+  m_pipeline = FilterPipeline(m_ds);
+  if (not m_pipeline.supported()) {
+    MsgLog(logger, debug, "ChunkReader: dataset " << m_ds.name() << " uses unsupported filters");
+    return;
+  }
+
+  m_chunk.resize(H5S_MAX_RANK);
+  m_chunk.resize(m_ds.chunkDims(&m_chunk.front()));
+  m_elemSize = m_type.size();
+  m_chunkBytes = m_elemSize;
+  for (unsigned i = 0; i != m_chunk.size(); ++ i) m_chunkBytes *= m_chunk[i];
+
+  m_pool.reset(new WorkerPool(nThreads));
+  if (m_maxPending == 0) m_maxPending = 4 * m_pool->size();
+#endif
+}
+
+bool
+ChunkReader::Impl::supported(const Type& native_type) const
+{
+  if (not m_pool) return false;
+
+  hid_t ftype = m_type.id();
+  htri_t eq = H5Tequal(native_type.id(), ftype);
+  if (eq < 0) throw Hdf5CallException( ERR_LOC, "H5Tequal" ) ;
+  if (eq == 0) return false;
+
+  // raw bytes of variable-length data are not usable in memory
+  if (H5Tdetect_class(ftype, H5T_VLEN) != 0) return false;
+  if (H5Tget_class(ftype) == H5T_STRING and H5Tis_variable_str(ftype) != 0) return false;
+  return true;
+}
+
+void
+ChunkReader::Impl::read(char* data, const Type& native_type)
+{
+  if (m_size == 0) return;
+
+  if (m_rank == 0) {
+    // scalar dataset
+    m_ds.read(DataSpace::makeScalar(), DataSpace::makeAll(), data, native_type);
+    return;
+  }
+
+  if (not supported(native_type)) {
+    // fall back to regular read of the whole dataset
+    std::vector<hsize_t> offset(m_rank, 0);
+    readRegion(data, &offset.front(), &m_dims.front(), native_type);
+    return;
+  }
+
+  // grid of chunks
+  std::vector<hsize_t> nchunks(m_rank), idx(m_rank, 0), offset(m_rank), count(m_rank);
+  for (unsigned i = 0; i != m_rank; ++ i) nchunks[i] = (m_dims[i] + m_chunk[i] - 1) / m_chunk[i];
+
+  m_error.clear();
+  try {
+    while (true) {
+
+      for (unsigned i = 0; i != m_rank; ++ i) offset[i] = idx[i] * m_chunk[i];
+
+      JobPtr job = boost::make_shared<Job>();
+      job->offset = offset;
+      job->mask = 0;
+      if (m_ds.readChunk(&offset.front(), job->mask, job->data)) {
+        wait(m_maxPending - 1);
+        {
+          boost::mutex::scoped_lock lock(m_mutex);
+          if (not m_error.empty()) break;
+          ++ m_inFlight;
+        }
+        m_pool->submit(boost::bind(&Impl::decode, this, job, data));
+      } else {
+        // no storage allocated, let HDF5 produce fill values
+        for (unsigned i = 0; i != m_rank; ++ i) count[i] = std::min(m_chunk[i], m_dims[i] - offset[i]);
+        readRegion(data, &offset.front(), &count.front(), native_type);
+      }
+
+      // next chunk in C order
+      int i = m_rank - 1;
+      for (; i >= 0; -- i) {
+        if (++ idx[i] < nchunks[i]) break;
+        idx[i] = 0;
+      }
+      if (i < 0) break;
+    }
+  } catch (...) {
+    // workers are still using destination buffer
+    wait(0);
+    throw;
+  }
+
+  wait(0);
+  if (not m_error.empty()) {
+    throw Exception(ERR_LOC, "ChunkReader", "failed to decode chunk of dataset " + m_ds.name() + ": " + m_error);
+  }
+}
+
+void
+ChunkReader::Impl::readRegion(char* data, const hsize_t offset[], const hsize_t count[], const Type& native_type)
+{
+  DataSpace fileDsp = m_ds.dataSpace();
+  DataSpace memDsp = DataSpace::makeSimple(m_rank, &m_dims.front(), &m_dims.front());
+  fileDsp.select_hyperslab(H5S_SELECT_SET, offset, 0, count, 0);
+  memDsp.select_hyperslab(H5S_SELECT_SET, offset, 0, count, 0);
+  m_ds.read(memDsp, fileDsp, data, native_type);
+}
+
+void
+ChunkReader::Impl::wait(size_t maxPending)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  while (m_inFlight > maxPending) m_cond.wait(lock);
+}
+
+void
+ChunkReader::Impl::decode(const JobPtr& job, char* data)
+{
+  std::string error;
+  try {
+
+    std::vector<char> buf;
+    m_pipeline.decode(&job->data.front(), job->data.size(), job->mask, m_chunkBytes, buf);
+
+    // copy rows of the chunk which are inside dataset extent
+    std::vector<hsize_t> count(m_rank);
+    for (unsigned i = 0; i != m_rank; ++ i) count[i] = std::min(m_chunk[i], m_dims[i] - job->offset[i]);
+    const size_t rowBytes = count[m_rank-1] * m_elemSize;
+    std::vector<hsize_t> pos(m_rank, 0);
+    while (true) {
+      hsize_t src = 0, dst = 0;
+      for (unsigned i = 0; i != m_rank; ++ i) {
+        src = src * m_chunk[i] + pos[i];
+        dst = dst * m_dims[i] + job->offset[i] + pos[i];
+      }
+      std::memcpy(data + dst*m_elemSize, &buf[src*m_elemSize], rowBytes);
+
+      int i = m_rank - 2;
+      for (; i >= 0; -- i) {
+        if (++ pos[i] < count[i]) break;
+        pos[i] = 0;
+      }
+      if (i < 0) break;
+    }
+
+  } catch (const std::exception& ex) {
+    error = ex.what();
+  }
+
+  boost::mutex::scoped_lock lock(m_mutex);
+  if (not error.empty() and m_error.empty()) m_error = error;
+  -- m_inFlight;
+  m_cond.notify_all();
+}
+
+//----------------
+// Constructors --
+//----------------
+ChunkReader::ChunkReader(const DataSet& ds, unsigned nThreads, unsigned maxPending)
+  : m_impl(new Impl(ds, nThreads, maxPending))
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+ChunkReader::~ChunkReader()
+{
+}
+
+// Returns true if data of given in-memory type can be read in parallel
+bool
+ChunkReader::supported(const Type& native_type) const
+{
+  return m_impl->supported(native_type);
+}
+
+// Get dimensions of the data returned by read(), returns dataset rank
+unsigned
+ChunkReader::dimensions(hsize_t dims[]) const
+{
+  std::copy(m_impl->m_dims.begin(), m_impl->m_dims.end(), dims);
+  return m_impl->m_rank;
+}
+
+// Read whole dataset.
+void
+ChunkReader::read(void* data, const Type& native_type)
+{
+  m_impl->read(static_cast<char*>(data), native_type);
+}
+
+// Get dataset object
+DataSet
+ChunkReader::dataSet() const
+{
+  return m_impl->m_ds;
+}
+
+} // namespace hdf5pp
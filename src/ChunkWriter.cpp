@@ -0,0 +1,362 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class ChunkWriter...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/ChunkWriter.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/DataSpace.h"
+#include "hdf5pp/Exceptions.h"
+#include "hdf5pp/FilterPipeline.h"
+#include "MsgLogger/MsgLogger.h"
+#include "WorkerPool.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.ChunkWriter";
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Implementation is shared between all copies of the writer.
+struct ChunkWriter::Impl {
+
+  // One chunk on its way to a file
+  struct Job {
+    Job() : extent(0), mask(0), done(false) {}
+    std::vector<hsize_t> offset;  ///< Chunk offset
+    hsize_t extent;               ///< Dataset size needed for this chunk (rank-1 only)
+    std::vector<char> data;       ///< Raw data, replaced with filtered data by worker
+    uint32_t mask;                ///< Filter mask
+    bool done;                    ///< Set by worker when data are filtered
+    std::string error;            ///< Error message from worker
+  };
+  typedef boost::shared_ptr<Job> JobPtr;
+
+  Impl(const DataSet& ds, const Type& native_type, unsigned nThreads, unsigned maxPending);
+  ~Impl();
+
+  void append(const char* data, hsize_t count);
+  void write(const char* data, const hsize_t dims[], const hsize_t offset[]);
+  void flush();
+
+  // send chunk to workers, write finished chunks
+  void submit(const JobPtr& job);
+
+  // write finished chunks in order, wait for oldest chunks until no more
+  // than maxPending remain in flight
+  void writeDone(size_t maxPending);
+
+  // runs in worker thread
+  void encode(const JobPtr& job);
+
+  DataSet m_ds;                  ///< Dataset to write to
+  FilterPipeline m_pipeline;     ///< Dataset filters
+  unsigned m_rank;               ///< Dataset rank
+  std::vector<hsize_t> m_chunk;  ///< Chunk dimensions
+  size_t m_elemSize;             ///< Size of one element
+  hsize_t m_chunkElems;          ///< Number of elements in a chunk
+  size_t m_maxPending;           ///< Max. number of chunks in flight
+  hsize_t m_size;                ///< Number of records appended so far (rank-1)
+  hsize_t m_extent;              ///< Dataset size as written so far (rank-1)
+  std::vector<char> m_partial;   ///< Records of the last incomplete chunk (rank-1)
+  hsize_t m_partialCount;        ///< Number of records in m_partial
+  std::deque<JobPtr> m_pending;  ///< Chunks in flight, in the order of submission
+  boost::mutex m_mutex;          ///< Protects job state shared with workers
+  boost::condition_variable m_cond;
+  WorkerPool m_pool;             ///< Must be last, threads are stopped first
+};
+
+ChunkWriter::Impl::Impl(const DataSet& ds, const Type& native_type, unsigned nThreads, unsigned maxPending)
+  : m_ds(ds)
+  , m_pipeline(ds)
+  , m_rank(0)
+  , m_chunk(H5S_MAX_RANK)
+  , m_elemSize(native_type.size())
+  , m_chunkElems(1)
+  , m_maxPending(maxPending)
+  , m_size(0)
+  , m_extent(0)
+  , m_partial()
+  , m_partialCount(0)
+  , m_pending()
+  , m_mutex()
+  , m_cond()
+  , m_pool(nThreads)
+{
+  if (not m_pipeline.supported()) {
+    throw Exception(ERR_LOC, "ChunkWriter", "dataset " + m_ds.name() + " uses unsupported filters");
+  }
+  htri_t eq = H5Tequal(native_type.id(), m_ds.type().id());
+  if (eq < 0) throw Hdf5CallException( ERR_LOC, "H5Tequal" ) ;
+  if (eq == 0) {
+    throw Exception(ERR_LOC, "ChunkWriter", "in-memory type differs from type of dataset " + m_ds.name());
+  }
+
+  m_rank = m_ds.chunkDims(&m_chunk.front());
+  m_chunk.resize(m_rank);
+  for (unsigned i = 0; i != m_rank; ++ i) m_chunkElems *= m_chunk[i];
+  if (m_maxPending == 0) m_maxPending = 4 * m_pool.size();
+
+  if (m_rank == 1) {
+    m_size = m_extent = m_ds.size();
+    m_partial.resize(m_chunkElems * m_elemSize);
+
+    // last chunk may be incomplete, it will be re-written so we need its data
+    m_partialCount = m_size % m_chunkElems;
+    if (m_partialCount > 0) {
+      hsize_t start[] = { m_size - m_partialCount };
+      hsize_t count[] = { m_partialCount };
+      DataSpace fileDsp = m_ds.dataSpace();
+      fileDsp.select_hyperslab(H5S_SELECT_SET, start, 0, count, 0);
+      DataSpace memDsp = DataSpace::makeSimple(m_partialCount, m_partialCount);
+      m_ds.read(memDsp, fileDsp, &m_partial.front(), native_type);
+    }
+  }
+
+  MsgLog(logger, debug, "ChunkWriter: dataset=" << m_ds.name() << " threads=" << m_pool.size()
+         << " chunk elements=" << m_chunkElems);
+}
+
+ChunkWriter::Impl::~Impl()
+{
+  // cannot let exceptions escape from destructor
+  try {
+    flush();
+  } catch (const std::exception& ex) {
+    MsgLog(logger, error, "ChunkWriter: failed to flush pending data: " << ex.what());
+  }
+}
+
+void
+ChunkWriter::Impl::append(const char* data, hsize_t count)
+{
+  if (m_rank != 1) throw Hdf5RankMismatch(ERR_LOC, 1, m_rank);
+
+  while (count > 0) {
+    hsize_t n = std::min(count, m_chunkElems - m_partialCount);
+    std::memcpy(&m_partial[m_partialCount * m_elemSize], data, n * m_elemSize);
+    m_partialCount += n;
+    m_size += n;
+    data += n * m_elemSize;
+    count -= n;
+
+    if (m_partialCount == m_chunkElems) {
+      JobPtr job = boost::make_shared<Job>();
+      job->offset.push_back(m_size - m_partialCount);
+      job->extent = m_size;
+      job->data.swap(m_partial);
+      m_partial.resize(m_chunkElems * m_elemSize);
+      m_partialCount = 0;
+      submit(job);
+    }
+  }
+}
+
+void
+ChunkWriter::Impl::write(const char* data, const hsize_t dims[], const hsize_t offset[])
+{
+  // check that array fits into dataset and is aligned on chunks
+  std::vector<hsize_t> origin(m_rank, 0);
+  if (offset) origin.assign(offset, offset+m_rank);
+  std::vector<hsize_t> extent(m_rank);
+  DataSpace dsp = m_ds.dataSpace();
+  if (dsp.rank() != m_rank) throw Hdf5RankMismatch(ERR_LOC, m_rank, dsp.rank());
+  dsp.dimensions(&extent.front());
+  for (unsigned i = 0; i != m_rank; ++ i) {
+    if (origin[i] % m_chunk[i] != 0) {
+      throw Exception(ERR_LOC, "ChunkWriter", "array offset is not aligned on chunk boundary");
+    }
+    if (origin[i] + dims[i] > extent[i]) throw Hdf5DataSpaceSizeException(ERR_LOC);
+    if (dims[i] == 0) return;
+  }
+
+  // number of chunks in each dimension
+  std::vector<hsize_t> nchunks(m_rank);
+  for (unsigned i = 0; i != m_rank; ++ i) nchunks[i] = (dims[i] + m_chunk[i] - 1) / m_chunk[i];
+
+  // iterate over all chunks covered by array
+  std::vector<hsize_t> cidx(m_rank, 0);
+  while (true) {
+
+    JobPtr job = boost::make_shared<Job>();
+    job->data.resize(m_chunkElems * m_elemSize);
+    job->offset.resize(m_rank);
+
+    // part of the chunk covered by the array
+    std::vector<hsize_t> start(m_rank), count(m_rank);
+    for (unsigned i = 0; i != m_rank; ++ i) {
+      start[i] = cidx[i] * m_chunk[i];
+      count[i] = std::min(m_chunk[i], dims[i] - start[i]);
+      job->offset[i] = origin[i] + start[i];
+    }
+
+    // copy rows along the last dimension, iterating over all other dimensions
+    const size_t rowBytes = count[m_rank-1] * m_elemSize;
+    std::vector<hsize_t> ridx(m_rank, 0);
+    while (true) {
+      hsize_t src = 0, dst = 0;
+      for (unsigned i = 0; i != m_rank; ++ i) {
+        src = src * dims[i] + start[i] + ridx[i];
+        dst = dst * m_chunk[i] + ridx[i];
+      }
+      std::memcpy(&job->data[dst * m_elemSize], data + src * m_elemSize, rowBytes);
+
+      int d = int(m_rank) - 2;
+      for (; d >= 0; -- d) {
+        if (++ ridx[d] < count[d]) break;
+        ridx[d] = 0;
+      }
+      if (d < 0) break;
+    }
+
+    submit(job);
+
+    int d = int(m_rank) - 1;
+    for (; d >= 0; -- d) {
+      if (++ cidx[d] < nchunks[d]) break;
+      cidx[d] = 0;
+    }
+    if (d < 0) break;
+  }
+}
+
+void
+ChunkWriter::Impl::flush()
+{
+  if (m_rank == 1 and m_partialCount > 0 and m_size > m_extent) {
+    // incomplete chunk is written padded with zeros and re-written later when it is filled
+    JobPtr job = boost::make_shared<Job>();
+    job->offset.push_back(m_size - m_partialCount);
+    job->extent = m_size;
+    job->data = m_partial;
+    std::fill(job->data.begin() + m_partialCount * m_elemSize, job->data.end(), 0);
+    submit(job);
+  }
+  writeDone(0);
+}
+
+void
+ChunkWriter::Impl::submit(const JobPtr& job)
+{
+  m_pending.push_back(job);
+  m_pool.submit(boost::bind(&Impl::encode, this, job));
+  writeDone(m_maxPending);
+}
+
+void
+ChunkWriter::Impl::writeDone(size_t maxPending)
+{
+  // m_pending is only used by this thread, only job state is shared with workers
+  while (not m_pending.empty()) {
+    JobPtr job = m_pending.front();
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+      if (not job->done and m_pending.size() <= maxPending) break;
+      while (not job->done) m_cond.wait(lock);
+    }
+    m_pending.pop_front();
+
+    if (not job->error.empty()) throw Exception(ERR_LOC, "ChunkWriter", job->error);
+
+    if (job->extent > m_extent) {
+      m_ds.resize(job->extent);
+      m_extent = job->extent;
+    }
+    m_ds.writeChunk(&job->offset.front(), job->mask, &job->data.front(), job->data.size());
+  }
+}
+
+void
+ChunkWriter::Impl::encode(const JobPtr& job)
+{
+  std::vector<char> out;
+  uint32_t mask = 0;
+  std::string error;
+  try {
+    mask = m_pipeline.encode(&job->data.front(), job->data.size(), out);
+  } catch (const std::exception& ex) {
+    error = ex.what();
+  }
+
+  boost::mutex::scoped_lock lock(m_mutex);
+  job->data.swap(out);
+  job->mask = mask;
+  job->error = error;
+  job->done = true;
+  m_cond.notify_all();
+}
+
+//----------------
+// Constructors --
+//----------------
+ChunkWriter::ChunkWriter(const DataSet& ds, const Type& native_type, unsigned nThreads, unsigned maxPending)
+  : m_impl(new Impl(ds, native_type, nThreads, maxPending))
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+ChunkWriter::~ChunkWriter()
+{
+}
+
+// Append records to the end of rank-1 dataset.
+void
+ChunkWriter::append(const void* data, hsize_t count)
+{
+  m_impl->append(static_cast<const char*>(data), count);
+}
+
+// Write rank-N array into a dataset.
+void
+ChunkWriter::write(const void* data, const hsize_t dims[], const hsize_t offset[])
+{
+  m_impl->write(static_cast<const char*>(data), dims, offset);
+}
+
+// Wait until all pending chunks are compressed and written.
+void
+ChunkWriter::flush()
+{
+  m_impl->flush();
+}
+
+// Get dataset object
+DataSet
+ChunkWriter::dataSet() const
+{
+  return m_impl->m_ds;
+}
+
+} // namespace hdf5pp
@@ -0,0 +1,63 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class CompoundTraitsHelper...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/CompoundTraits.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/CompoundType.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Build native type for a structure of given size.
+Type
+CompoundTraitsHelper::native_type(size_t size, const Members& members)
+{
+  CompoundType type = CompoundType::compoundType(size);
+  for (Members::const_iterator it = members.begin(); it != members.end(); ++ it) {
+    type.insert(it->name, it->offset, it->native);
+  }
+  return TypeCache::lockedCopy(type);
+}
+
+// Build packed stored type.
+Type
+CompoundTraitsHelper::stored_type(const Members& members)
+{
+  size_t size = 0;
+  for (Members::const_iterator it = members.begin(); it != members.end(); ++ it) {
+    size += it->stored.size();
+  }
+
+  CompoundType type = CompoundType::compoundType(size);
+  size_t offset = 0;
+  for (Members::const_iterator it = members.begin(); it != members.end(); ++ it) {
+    type.insert(it->name, offset, it->stored);
+    offset += it->stored.size();
+  }
+  return TypeCache::lockedCopy(type);
+}
+
+} // namespace hdf5pp
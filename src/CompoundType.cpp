@@ -21,6 +21,7 @@
 #include "hdf5/hdf5.h"
 #include "hdf5pp/ArrayType.h"
 #include "hdf5pp/Exceptions.h"
+#include "hdf5pp/TypeCache.h"
 
 //-------------------------------
 // Collaborating Class Headers --
@@ -50,7 +51,7 @@ CompoundType::insert ( const char* name, size_t offset, const Type& t, size_t si
 {
   Type mtype = t;
   if (size > 0) {
-    mtype = hdf5pp::ArrayType::arrayType(mtype, size);
+    mtype = hdf5pp::TypeCache::arrayType(mtype, size);
   }
   herr_t stat = H5Tinsert ( id(), name, offset, mtype.id() ) ;
   if ( stat < 0 ) throw Hdf5CallException ( ERR_LOC, "H5Tinsert" ) ;
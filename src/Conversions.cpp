@@ -0,0 +1,242 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class Conversions...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/Conversions.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <boost/thread/mutex.hpp>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Exceptions.h"
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.Conversions";
+
+  // number of elements converted in one block
+  const size_t blockSize = 1024;
+
+  // unsigned type of the same size as T
+  template <typename T> struct Bits {};
+  template <> struct Bits<int16_t> { typedef uint16_t type; };
+  template <> struct Bits<uint16_t> { typedef uint16_t type; };
+  template <> struct Bits<int32_t> { typedef uint32_t type; };
+  template <> struct Bits<uint32_t> { typedef uint32_t type; };
+  template <> struct Bits<int64_t> { typedef uint64_t type; };
+  template <> struct Bits<uint64_t> { typedef uint64_t type; };
+  template <> struct Bits<float> { typedef uint32_t type; };
+  template <> struct Bits<double> { typedef uint64_t type; };
+
+  // 16 and 32-bit swaps written with shifts vectorize without SSSE3
+  inline uint16_t bswap(uint16_t v) { return (v >> 8) | (v << 8); }
+  inline uint32_t bswap(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xff00u) | ((v << 8) & 0xff0000u) | (v << 24);
+  }
+  inline uint64_t bswap(uint64_t v) { return __builtin_bswap64(v); }
+
+  template <typename T>
+  inline T swapped(T v)
+  {
+    typename Bits<T>::type u;
+    std::memcpy(&u, &v, sizeof u);
+    u = bswap(u);
+    std::memcpy(&v, &u, sizeof v);
+    return v;
+  }
+
+  // conversion operations
+  template <typename S, typename D>
+  struct Cast {
+    typedef S src_type;
+    typedef D dst_type;
+    static D apply(S v) { return D(v); }
+  };
+
+  template <typename T>
+  struct Swap {
+    typedef T src_type;
+    typedef T dst_type;
+    static T apply(T v) { return swapped(v); }
+  };
+
+  template <typename S, typename D>
+  struct SwapCast {
+    typedef S src_type;
+    typedef D dst_type;
+    static D apply(S v) { return D(swapped(v)); }
+  };
+
+  // convert one block, loop has fixed number of iterations so that it can be vectorized
+  template <typename Op>
+  void convertBlock(const typename Op::src_type* in, typename Op::dst_type* out)
+  {
+    for (size_t i = 0; i != blockSize; ++ i) out[i] = Op::apply(in[i]);
+  }
+
+  // in-place conversion of aligned elements of the same size
+  template <typename Op>
+  void convertInPlace(typename Op::src_type* data, size_t nelmts)
+  {
+    typedef typename Op::dst_type D;
+    for (; nelmts >= blockSize; nelmts -= blockSize, data += blockSize) {
+      for (size_t i = 0; i != blockSize; ++ i) {
+        D d = Op::apply(data[i]);
+        std::memcpy(data+i, &d, sizeof d);
+      }
+    }
+    for (size_t i = 0; i != nelmts; ++ i) {
+      D d = Op::apply(data[i]);
+      std::memcpy(data+i, &d, sizeof d);
+    }
+  }
+
+  // in-place conversion of nelmts elements
+  template <typename Op>
+  void convert(char* buf, size_t nelmts, size_t stride)
+  {
+    typedef typename Op::src_type S;
+    typedef typename Op::dst_type D;
+
+    if (stride != 0) {
+      // elements are not adjacent (e.g. compound members), no blocking
+      for (size_t i = 0; i != nelmts; ++ i, buf += stride) {
+        S s;
+        std::memcpy(&s, buf, sizeof s);
+        D d = Op::apply(s);
+        std::memcpy(buf, &d, sizeof d);
+      }
+      return;
+    }
+
+    if (sizeof(S) == sizeof(D) and reinterpret_cast<size_t>(buf) % sizeof(S) == 0) {
+      // same size and aligned, convert in place
+      convertInPlace<Op>(reinterpret_cast<S*>(buf), nelmts);
+      return;
+    }
+
+    // Data is copied to aligned buffer, converted and copied back. When
+    // destination is wider than source blocks are processed from the end
+    // of the buffer, otherwise from the beginning, so that unconverted
+    // data are never overwritten.
+    S in[blockSize];
+    D out[blockSize];
+    bool backward = sizeof(D) > sizeof(S);
+    size_t done = 0;
+    while (done < nelmts) {
+      size_t n = std::min(blockSize, nelmts - done);
+      size_t begin = backward ? nelmts - done - n : done;
+      std::memcpy(in, buf + begin*sizeof(S), n*sizeof(S));
+      if (n < blockSize) std::fill(in+n, in+blockSize, S(0));
+      convertBlock<Op>(in, out);
+      std::memcpy(buf + begin*sizeof(D), out, n*sizeof(D));
+      done += n;
+    }
+  }
+
+  // conversion function in a format of H5T_conv_t
+  template <typename Op>
+  herr_t conv(hid_t, hid_t, H5T_cdata_t* cdata, size_t nelmts, size_t buf_stride,
+      size_t, void* buf, void*, hid_t)
+  {
+    switch (cdata->command) {
+    case H5T_CONV_INIT:
+      cdata->need_bkg = H5T_BKG_NO;
+      return 0;
+    case H5T_CONV_CONV:
+      convert<Op>(static_cast<char*>(buf), nelmts, buf_stride);
+      return 0;
+    case H5T_CONV_FREE:
+      return 0;
+    default:
+      return -1;
+    }
+  }
+
+  // register one conversion path
+  void reg(const std::string& name, hid_t src, hid_t dst, H5T_conv_t func)
+  {
+    std::string fullName = "hdf5pp_" + name;
+    herr_t stat = H5Tregister(H5T_PERS_HARD, fullName.c_str(), src, dst, func);
+    if (stat < 0) throw hdf5pp::Hdf5CallException(ERR_LOC, "H5Tregister");
+  }
+
+  // register byte swapping in both directions
+  template <typename T>
+  void regSwap(const std::string& name, hid_t native, hid_t swapped)
+  {
+    reg(name + "_swap", swapped, native, &conv<Swap<T> >);
+    reg(name + "_swap_back", native, swapped, &conv<Swap<T> >);
+  }
+
+  // register conversion from native and swapped source
+  template <typename S, typename D>
+  void regCast(const std::string& name, hid_t native, hid_t swapped, hid_t dst)
+  {
+    reg(name, native, dst, &conv<Cast<S, D> >);
+    reg(name + "_swap", swapped, dst, &conv<SwapCast<S, D> >);
+  }
+
+  unsigned registerAll()
+  {
+    bool le = H5Tget_order(H5T_NATIVE_INT) == H5T_ORDER_LE;
+
+    regSwap<int16_t>("int16", H5T_NATIVE_INT16, le ? H5T_STD_I16BE : H5T_STD_I16LE);
+    regSwap<uint16_t>("uint16", H5T_NATIVE_UINT16, le ? H5T_STD_U16BE : H5T_STD_U16LE);
+    regSwap<int32_t>("int32", H5T_NATIVE_INT32, le ? H5T_STD_I32BE : H5T_STD_I32LE);
+    regSwap<uint32_t>("uint32", H5T_NATIVE_UINT32, le ? H5T_STD_U32BE : H5T_STD_U32LE);
+    regSwap<int64_t>("int64", H5T_NATIVE_INT64, le ? H5T_STD_I64BE : H5T_STD_I64LE);
+    regSwap<uint64_t>("uint64", H5T_NATIVE_UINT64, le ? H5T_STD_U64BE : H5T_STD_U64LE);
+    regSwap<float>("float", H5T_NATIVE_FLOAT, le ? H5T_IEEE_F32BE : H5T_IEEE_F32LE);
+    regSwap<double>("double", H5T_NATIVE_DOUBLE, le ? H5T_IEEE_F64BE : H5T_IEEE_F64LE);
+
+    regCast<int16_t, float>("int16_float", H5T_NATIVE_INT16, le ? H5T_STD_I16BE : H5T_STD_I16LE, H5T_NATIVE_FLOAT);
+    regCast<uint16_t, int32_t>("uint16_int32", H5T_NATIVE_UINT16, le ? H5T_STD_U16BE : H5T_STD_U16LE, H5T_NATIVE_INT32);
+    regCast<double, float>("double_float", H5T_NATIVE_DOUBLE, le ? H5T_IEEE_F64BE : H5T_IEEE_F64LE, H5T_NATIVE_FLOAT);
+
+    unsigned count = 8*2 + 3*2;
+    MsgLog(logger, debug, "Conversions: registered " << count << " conversion functions");
+    return count;
+  }
+
+  boost::mutex g_mutex;
+  unsigned g_count = 0;
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Register conversion functions.
+unsigned
+Conversions::init()
+{
+  boost::mutex::scoped_lock lock(g_mutex);
+  if (g_count == 0) g_count = registerAll();
+  return g_count;
+}
+
+} // namespace hdf5pp
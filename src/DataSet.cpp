@@ -18,10 +18,16 @@
 //-----------------
 // C/C++ Headers --
 //-----------------
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <boost/make_shared.hpp>
 
 //-------------------------------
 // Collaborating Class Headers --
 //-------------------------------
+#include "hdf5/hdf5_hl.h"
 #include "hdf5pp/Exceptions.h"
 #include "MsgLogger/MsgLogger.h"
 
@@ -33,15 +39,18 @@ namespace {
 
   char logger[] = "hdf5pp.DataSet";
 
-  // deleter for  boost smart pointer
-  struct DataSetPtrDeleter {
-    void operator()( hid_t* id ) {
-      if ( id ) {
-        MsgLog(logger, debug, "DataSetPtrDeleter: dataset=" << *id) ;
-        H5Dclose ( *id );
-      }
-      delete id ;
-    }
+  // name of the attribute which keeps logical size of datasets with reserved extent
+  const char sizeAttrName[] = "_hdf5pp_size";
+
+  // global conversion check setting
+  hdf5pp::DataSet::ConversionCheck g_conversionCheck = hdf5pp::DataSet::ConversionAllow;
+
+  // deleter for memory-mapped dataset data
+  struct Unmapper {
+    Unmapper(void* addr, size_t size) : addr(addr), size(size) {}
+    void operator()(const void*) const { munmap(addr, size); }
+    void* addr;
+    size_t size;
   };
 
 }
@@ -52,10 +61,145 @@ namespace {
 
 namespace hdf5pp {
 
+struct DataSet::Extent {
+
+  Extent() : reserve(false), growth(1), maxStep(0), chunk(1), logical(0), physical(0), stored(0),
+             attr(-1), checked(false) {}
+
+  // open logical size attribute if it exists or create it if create is true,
+  // returns false if attribute does not exist, attribute stays open until
+  // dataset is closed
+  bool openAttr(hid_t id, bool create)
+  {
+    if (attr >= 0) return true;
+    htri_t rc = 0;
+    if (not checked) {
+      // existence is checked once per handle, not for every size() call
+      rc = H5Aexists(id, sizeAttrName);
+      if ( rc < 0 ) throw Hdf5CallException( ERR_LOC, "H5Aexists" ) ;
+      checked = true;
+    }
+    if (rc > 0) {
+      attr = H5Aopen(id, sizeAttrName, H5P_DEFAULT);
+      if ( attr < 0 ) throw Hdf5CallException( ERR_LOC, "H5Aopen" ) ;
+    } else if (create) {
+      DataSpace dsp = DataSpace::makeScalar();
+      attr = H5Acreate2(id, sizeAttrName, TypeTraits<uint64_t>::stored_type().id(), dsp.id(), H5P_DEFAULT, H5P_DEFAULT);
+      if ( attr < 0 ) throw Hdf5CallException( ERR_LOC, "H5Acreate2" ) ;
+    }
+    return attr >= 0;
+  }
+
+  // read logical size from attribute, attribute must be open
+  hsize_t readSize()
+  {
+    uint64_t value;
+    herr_t stat = H5Aread(attr, TypeTraits<uint64_t>::native_type().id(), &value);
+    if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Aread" ) ;
+    return value;
+  }
+
+  // store logical size in attribute, attribute must be open
+  void storeSize(hsize_t size)
+  {
+    uint64_t value = size;
+    herr_t stat = H5Awrite(attr, TypeTraits<uint64_t>::native_type().id(), &value);
+    if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Awrite" ) ;
+    stored = size;
+  }
+
+  // shrink physical extent to logical size, update attribute
+  void trim(hid_t id)
+  {
+    if (physical != logical) {
+      herr_t stat = H5Dset_extent(id, &logical);
+      if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Dset_extent" ) ;
+      physical = logical;
+    }
+    openAttr(id, true);
+    storeSize(logical);
+  }
+
+  // close attribute
+  void close()
+  {
+    if (attr >= 0) H5Aclose(attr);
+    attr = -1;
+  }
+
+  bool reserve;       ///< True if reservation is enabled
+  double growth;      ///< Growth factor
+  hsize_t maxStep;    ///< Max growth step, 0 for unlimited
+  hsize_t chunk;      ///< Chunk size, physical extent is always multiple of this
+  hsize_t logical;    ///< Logical dataset size
+  hsize_t physical;   ///< Physical dataset size
+  hsize_t stored;     ///< Logical size last stored in attribute
+  hid_t attr;         ///< Logical size attribute, negative if not open
+  bool checked;       ///< True if attribute existence was checked already
+};
+
+struct DataSet::IdDeleter {
+  IdDeleter(const boost::shared_ptr<Extent>& extent) : m_extent(extent) {}
+  void operator()( hid_t* id ) {
+    if ( id ) {
+      MsgLog(logger, debug, "DataSet::IdDeleter: dataset=" << *id) ;
+      if (m_extent->reserve) {
+        // cannot let exceptions escape from here
+        try {
+          m_extent->trim(*id);
+        } catch (const std::exception& ex) {
+          MsgLog(logger, error, "DataSet::IdDeleter: failed to trim dataset extent: " << ex.what());
+        }
+      }
+      m_extent->close();
+      H5Dclose ( *id );
+    }
+    delete id ;
+  }
+  boost::shared_ptr<Extent> m_extent;
+};
+
+struct DataSet::Conversion {
+
+  Conversion() : fileType(), memType(), noop(false), bytes(0), count(0) {}
+
+  // compare in-memory type with dataset type, result for last type is remembered,
+  // copy of that type is kept so its ID cannot be reused for different type
+  bool check(const Type& type)
+  {
+    if (known(type)) return noop;
+
+    htri_t eq = H5Tequal(fileType.id(), type.id());
+    if ( eq < 0 ) throw Hdf5CallException( ERR_LOC, "H5Tequal" ) ;
+    bool result = eq > 0;
+    if (result) {
+      htri_t vlen = H5Tdetect_class(type.id(), H5T_VLEN);
+      if ( vlen < 0 ) throw Hdf5CallException( ERR_LOC, "H5Tdetect_class" ) ;
+      result = vlen == 0 and not (type.tclass() == H5T_STRING and H5Tis_variable_str(type.id()) > 0);
+    }
+
+    memType = type;
+    noop = result;
+    return noop;
+  }
+
+  // true if type was checked last time
+  bool known(const Type& type) const { return memType.valid() and memType.id() == type.id(); }
+
+  Type fileType;            ///< Dataset type
+  Type memType;             ///< Last checked in-memory type
+  bool noop;                ///< True if last checked type needs no conversion
+  uint64_t bytes;           ///< Number of bytes converted
+  unsigned long count;      ///< Number of reads/writes with conversion
+};
+
 DataSet::DataSet(hid_t id)
-  : m_id( new hid_t(id), DataSetPtrDeleter() )
+  : m_extent( boost::make_shared<Extent>() )
+  , m_id( new hid_t(id), IdDeleter(m_extent) )
+  , m_conv( boost::make_shared<Conversion>() )
 {
   MsgLog(logger, debug, "DataSet ctor: " << id) ;
+  m_conv->fileType = type();
 }
 
 /// create new data set, specify the type explicitly
@@ -91,6 +235,91 @@ DataSet::set_extent(const hsize_t size[])
 {
   herr_t stat = H5Dset_extent( *m_id, size ) ;
   if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Dset_extent" ) ;
+  if (m_extent->reserve) {
+    // explicit extent change overrides reservation
+    m_extent->logical = m_extent->physical = size[0];
+    m_extent->openAttr(*m_id, true);
+    m_extent->storeSize(size[0]);
+  } else if (m_extent->openAttr(*m_id, false)) {
+    // dataset was written with reservation before, keep logical size current
+    m_extent->storeSize(size[0]);
+  }
+}
+
+// Enable extent reservation for rank-1 extensible dataset.
+void
+DataSet::set_reserve(double growth, hsize_t maxStep)
+{
+  DataSpace dsp = dataSpace();
+  unsigned rank = dsp.rank();
+  if (rank != 1) throw Hdf5RankMismatch(ERR_LOC, 1, rank);
+  hsize_t dims[1], maxdims[1];
+  dsp.dimensions(dims, maxdims);
+
+  Extent& ext = *m_extent;
+  ext.growth = std::max(growth, 1.0);
+  ext.maxStep = maxStep;
+  ext.chunk = chunkSize();
+  ext.physical = dims[0];
+  ext.logical = dims[0];
+
+  // dataset may have been left with reserved extent by somebody else
+  if (ext.openAttr(*m_id, false)) ext.logical = std::min(ext.readSize(), ext.physical);
+
+  // readers which open dataset independently use the attribute for its size
+  ext.openAttr(*m_id, true);
+  ext.storeSize(ext.logical);
+  ext.reserve = true;
+}
+
+// Get size of rank-1 dataset, with reservation enabled this is logical size.
+hsize_t
+DataSet::size()
+{
+  if (m_extent->reserve) return m_extent->logical;
+  hsize_t size = dataSpace().size();
+  // dataset may be written with reservation through other handle or by other process
+  if (m_extent->openAttr(*m_id, false)) size = std::min(m_extent->readSize(), size);
+  return size;
+}
+
+// Change size of rank-1 dataset, with reservation enabled this may reserve more space.
+void
+DataSet::resize(hsize_t size)
+{
+  Extent& ext = *m_extent;
+  if (not ext.reserve) {
+    set_extent(size);
+    return;
+  }
+
+  bool grow = size > ext.physical;
+  if (grow) {
+    hsize_t step = hsize_t(ext.physical * (ext.growth - 1));
+    if (ext.maxStep > 0 and step > ext.maxStep) step = ext.maxStep;
+    hsize_t newSize = std::max(size, ext.physical + step);
+    newSize = (newSize + ext.chunk - 1) / ext.chunk * ext.chunk;
+
+    MsgLog(logger, debug, "DataSet::resize: reserve extent " << newSize << " for size " << size) ;
+    herr_t stat = H5Dset_extent( *m_id, &newSize ) ;
+    if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Dset_extent" ) ;
+    ext.physical = newSize;
+  }
+  ext.logical = size;
+  // attribute is only updated when extent grows (or when size drops below
+  // stored value), between updates other readers see smaller size which
+  // covers data that is already written; flush() makes it exact
+  if (grow or size < ext.stored) {
+    ext.openAttr(*m_id, true);
+    ext.storeSize(size);
+  }
+}
+
+// Trim reserved extent to logical size and store logical size in attribute.
+void
+DataSet::flush()
+{
+  if (m_extent->reserve) m_extent->trim(*m_id);
 }
 
 
@@ -101,7 +330,8 @@ DataSet::_store(const Type& memType,
                 const DataSpace& fileDspc,
                 const void* data)
 {
-  
+  _checkConversion(memType, memDspc, fileDspc);
+
   herr_t stat = H5Dwrite( *m_id, memType.id(), memDspc.id(), fileDspc.id(), H5P_DEFAULT, data ) ;
   if ( stat < 0 ) {
     MsgLog(logger, error, "H5Dwrite failed, h5 type for memory: " 
@@ -115,9 +345,12 @@ void
 DataSet::_read(const Type& memType,
                const DataSpace& memDspc,
                const DataSpace& fileDspc,
-               void* data)
+               void* data,
+               hid_t plistXfer)
 {
-  herr_t stat = H5Dread(*m_id, memType.id(), memDspc.id(), fileDspc.id(), H5P_DEFAULT, data);
+  _checkConversion(memType, memDspc, fileDspc);
+
+  herr_t stat = H5Dread(*m_id, memType.id(), memDspc.id(), fileDspc.id(), plistXfer, data);
   if ( stat < 0 ) {
     MsgLog(logger, error, "H5Dread failed, h5 type for memory: " 
            << memType << " h5 type for file: " << type() << " dataset name: " << name());
@@ -125,6 +358,36 @@ DataSet::_read(const Type& memType,
   }
 }
 
+// check conversion before read or write, update counters
+void
+DataSet::_checkConversion(const Type& memType, const DataSpace& memDspc, const DataSpace& fileDspc)
+{
+  bool known = m_conv->known(memType);
+  if (m_conv->check(memType)) return;
+
+  if (g_conversionCheck == ConversionThrow) {
+    MsgLog(logger, error, "type conversion needed, h5 type for memory: "
+           << memType << " h5 type for file: " << m_conv->fileType << " dataset name: " << name());
+    throw Hdf5TypeConversion(ERR_LOC, name());
+  } else if (g_conversionCheck == ConversionWarn and not known) {
+    MsgLog(logger, warning, "type conversion needed, h5 type for memory: "
+           << memType << " h5 type for file: " << m_conv->fileType << " dataset name: " << name());
+  }
+
+  // number of converted elements is determined by memory selection, or by
+  // file selection, or by the whole dataset
+  hssize_t npoints;
+  if (memDspc.id() != H5S_ALL) {
+    npoints = H5Sget_select_npoints(memDspc.id());
+  } else if (fileDspc.id() != H5S_ALL) {
+    npoints = H5Sget_select_npoints(fileDspc.id());
+  } else {
+    npoints = H5Sget_select_npoints(dataSpace().id());
+  }
+  if (npoints > 0) m_conv->bytes += npoints * memType.size();
+  ++ m_conv->count;
+}
+
 // reclaim space allocated to vlen structures
 void
 DataSet::_vlen_reclaim(const hdf5pp::Type& type, const DataSpace& memDspc, void* data)
@@ -133,6 +396,41 @@ DataSet::_vlen_reclaim(const hdf5pp::Type& type, const DataSpace& memDspc, void*
   if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Dvlen_reclaim" ) ;
 }
 
+// Check whether reading or writing with given in-memory type needs no conversion.
+bool
+DataSet::noopConversion(const Type& native_type)
+{
+  return m_conv->check(native_type);
+}
+
+// Get number of bytes converted by reads and writes
+uint64_t
+DataSet::convertedBytes() const
+{
+  return m_conv->bytes;
+}
+
+// Get number of reads and writes that needed conversion
+unsigned long
+DataSet::conversions() const
+{
+  return m_conv->count;
+}
+
+// Set action taken for reads and writes that need data type conversion.
+void
+DataSet::setConversionCheck(ConversionCheck check)
+{
+  g_conversionCheck = check;
+}
+
+// Get action taken for reads and writes that need data type conversion
+DataSet::ConversionCheck
+DataSet::conversionCheck()
+{
+  return g_conversionCheck;
+}
+
 /// access data space
 DataSpace
 DataSet::dataSpace()
@@ -155,6 +453,152 @@ DataSet::chunkSize() const
   return dims[0];
 }
 
+// get chunk dimensions, size of dims array must be at least rank of the dataset
+unsigned
+DataSet::chunkDims(hsize_t dims[]) const
+{
+  hid_t plist = H5Dget_create_plist(*m_id);
+  if (plist < 0) throw Hdf5CallException( ERR_LOC, "H5Dget_create_plist" ) ;
+  int nd = H5Pget_chunk(plist, H5S_MAX_RANK, dims);
+  H5Pclose(plist);
+  if (nd < 0) throw Hdf5CallException( ERR_LOC, "H5Pget_chunk" ) ;
+  return nd;
+}
+
+// Write raw chunk data bypassing HDF5 filter pipeline.
+void
+DataSet::writeChunk(const hsize_t offset[], uint32_t filterMask, const void* data, size_t size)
+{
+#if H5_VERSION_GE(1,10,2)
+  herr_t stat = H5Dwrite_chunk(*m_id, H5P_DEFAULT, filterMask, offset, size, data);
+  if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Dwrite_chunk" ) ;
+#else
+  herr_t stat = H5DOwrite_chunk(*m_id, H5P_DEFAULT, filterMask, offset, size, data);
+  if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5DOwrite_chunk" ) ;
+#endif
+}
+
+// Read raw chunk data bypassing HDF5 filter pipeline.
+bool
+DataSet::readChunk(const hsize_t offset[], uint32_t& filterMask, std::vector<char>& data)
+{
+#if H5_VERSION_GE(1,10,0)
+  hsize_t nbytes = 0;
+#if H5_VERSION_GE(1,10,5)
+  unsigned mask = 0;
+  haddr_t addr = HADDR_UNDEF;
+  herr_t stat = H5Dget_chunk_info_by_coord(*m_id, offset, &mask, &addr, &nbytes);
+  if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Dget_chunk_info_by_coord" ) ;
+  if (addr == HADDR_UNDEF) nbytes = 0;
+#else
+  // fails for chunks which are not allocated
+  herr_t stat;
+  H5E_BEGIN_TRY {
+    stat = H5Dget_chunk_storage_size(*m_id, offset, &nbytes);
+  } H5E_END_TRY;
+  if ( stat < 0 ) nbytes = 0;
+#endif
+  data.resize(nbytes);
+  if (nbytes == 0) return false;
+
+#if H5_VERSION_GE(1,10,2)
+  stat = H5Dread_chunk(*m_id, H5P_DEFAULT, offset, &filterMask, &data.front());
+  if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Dread_chunk" ) ;
+#else
+  stat = H5DOread_chunk(*m_id, H5P_DEFAULT, offset, &filterMask, &data.front());
+  if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5DOread_chunk" ) ;
+#endif
+  return true;
+#else
+  throw Exception(ERR_LOC, "DataSet", "readChunk() needs HDF5 1.10.0 or later");
+#endif
+}
+
+// Check whether dataset can be memory-mapped with mapView().
+bool
+DataSet::mappable(const Type& native_type)
+{
+  hid_t plist = H5Dget_create_plist(*m_id);
+  if (plist < 0) throw Hdf5CallException( ERR_LOC, "H5Dget_create_plist" ) ;
+  H5D_layout_t layout = H5Pget_layout(plist);
+  int nfilters = H5Pget_nfilters(plist);
+  int nexternal = H5Pget_external_count(plist);
+  H5Pclose(plist);
+  if (layout != H5D_CONTIGUOUS or nfilters != 0 or nexternal != 0) return false;
+
+  if (H5Dget_offset(*m_id) == HADDR_UNDEF) return false;
+
+  Type ftype = type();
+  htri_t eq = H5Tequal(native_type.id(), ftype.id());
+  if (eq < 0) throw Hdf5CallException( ERR_LOC, "H5Tequal" ) ;
+  if (eq == 0 or H5Tdetect_class(ftype.id(), H5T_VLEN) != 0) return false;
+  if (H5Tget_class(ftype.id()) == H5T_STRING and H5Tis_variable_str(ftype.id()) != 0) return false;
+
+  // data have to be in a single file
+  hid_t fid = H5Iget_file_id(*m_id);
+  if (fid < 0) throw Hdf5CallException( ERR_LOC, "H5Iget_file_id" ) ;
+  hid_t fapl = H5Fget_access_plist(fid);
+  H5Fclose(fid);
+  if (fapl < 0) throw Hdf5CallException( ERR_LOC, "H5Fget_access_plist" ) ;
+  hid_t driver = H5Pget_driver(fapl);
+  H5Pclose(fapl);
+  return driver == H5FD_SEC2;
+}
+
+// true if handle must stay open: it is used by other copies or has extent reservation
+bool
+DataSet::_pinned() const
+{
+  return m_id.use_count() > 1 or m_extent->reserve;
+}
+
+// map dataset data into memory, returns dimensions in dims
+boost::shared_ptr<const void>
+DataSet::_mapView(const Type& native_type, unsigned rank, hsize_t dims[])
+{
+  if (not mappable(native_type)) {
+    throw Exception(ERR_LOC, "DataSet", "dataset " + name() + " cannot be memory-mapped");
+  }
+
+  DataSpace dsp = dataSpace();
+  unsigned dsRank = dsp.rank();
+  if (dsRank != rank) throw Hdf5RankMismatch(ERR_LOC, rank, dsRank);
+  dsp.dimensions(dims);
+  size_t size = native_type.size();
+  for (unsigned i = 0; i != rank; ++ i) size *= dims[i];
+  if (size == 0) return boost::shared_ptr<const void>();
+
+  // get file name, make sure all data are on disk
+  hid_t fid = H5Iget_file_id(*m_id);
+  if (fid < 0) throw Hdf5CallException( ERR_LOC, "H5Iget_file_id" ) ;
+  unsigned intent = 0;
+  if (H5Fget_intent(fid, &intent) < 0 or ((intent & H5F_ACC_RDWR) and H5Fflush(fid, H5F_SCOPE_LOCAL) < 0)) {
+    H5Fclose(fid);
+    throw Hdf5CallException( ERR_LOC, "H5Fflush" ) ;
+  }
+  ssize_t len = H5Fget_name(fid, 0, 0);
+  std::vector<char> fname(len > 0 ? len+1 : 1);
+  if (len > 0) H5Fget_name(fid, &fname.front(), fname.size());
+  H5Fclose(fid);
+  if (len <= 0) throw Hdf5CallException( ERR_LOC, "H5Fget_name" ) ;
+
+  // mapping must start at page boundary
+  haddr_t offset = H5Dget_offset(*m_id);
+  size_t pageSize = sysconf(_SC_PAGESIZE);
+  size_t pageOffset = offset % pageSize;
+
+  int fd = ::open(&fname.front(), O_RDONLY);
+  if (fd < 0) throw Exception(ERR_LOC, "DataSet", "failed to open file " + std::string(&fname.front()));
+  void* addr = mmap(0, size + pageOffset, PROT_READ, MAP_SHARED, fd, offset - pageOffset);
+  ::close(fd);
+  if (addr == MAP_FAILED) throw Exception(ERR_LOC, "DataSet", "mmap failed for dataset " + name());
+
+  MsgLog(logger, debug, "DataSet::mapView: dataset=" << name() << " offset=" << offset << " size=" << size);
+
+  const void* data = static_cast<const char*>(addr) + pageOffset;
+  return boost::shared_ptr<const void>(data, Unmapper(addr, size + pageOffset));
+}
+
 /// access dataset type
 Type
 DataSet::type()
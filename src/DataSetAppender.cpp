@@ -0,0 +1,177 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class DataSetAppender...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/DataSetAppender.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <cstring>
+#include <vector>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/DataSpace.h"
+#include "hdf5pp/Exceptions.h"
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.DataSetAppender";
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Implementation is shared between all copies of the appender,
+// destructor writes whatever is left in the buffer.
+struct DataSetAppender::Impl {
+
+  Impl(const DataSet& ds, const Type& native_type, hsize_t bufSize);
+  ~Impl();
+
+  void append(const void* data);
+  void flush();
+
+  DataSet m_ds;               ///< Dataset to write to
+  Type m_type;                ///< In-memory type of records
+  size_t m_recSize;           ///< Size of one record in memory
+  hsize_t m_bufSize;          ///< Buffer size in records
+  hsize_t m_size;             ///< Dataset size, not including buffered records
+  hsize_t m_count;            ///< Number of buffered records
+  hsize_t m_limit;            ///< Number of records after which buffer is flushed
+  std::vector<char> m_buffer; ///< Records buffer
+};
+
+DataSetAppender::Impl::Impl(const DataSet& ds, const Type& native_type, hsize_t bufSize)
+  : m_ds(ds)
+  , m_type(native_type)
+  , m_recSize(native_type.size())
+  , m_bufSize(bufSize)
+  , m_size(0)
+  , m_count(0)
+  , m_limit(0)
+  , m_buffer()
+{
+  unsigned rank = m_ds.dataSpace().rank();
+  if (rank != 1) throw Hdf5RankMismatch(ERR_LOC, 1, rank);
+  m_size = m_ds.size();
+
+  if (m_bufSize == 0) m_bufSize = m_ds.chunkSize();
+
+  // first batch only fills the rest of the current chunk
+  m_limit = m_bufSize - m_size % m_bufSize;
+  m_buffer.resize(m_bufSize * m_recSize);
+
+  MsgLog(logger, debug, "DataSetAppender: dataset=" << m_ds.name() << " size=" << m_size
+         << " bufSize=" << m_bufSize);
+}
+
+DataSetAppender::Impl::~Impl()
+{
+  // cannot let exceptions escape from destructor
+  try {
+    flush();
+  } catch (const std::exception& ex) {
+    MsgLog(logger, error, "DataSetAppender: failed to flush buffered data: " << ex.what());
+  }
+}
+
+void
+DataSetAppender::Impl::append(const void* data)
+{
+  std::memcpy(&m_buffer[m_count * m_recSize], data, m_recSize);
+  if (++ m_count == m_limit) flush();
+}
+
+void
+DataSetAppender::Impl::flush()
+{
+  if (m_count == 0) return;
+
+  // extend dataset once for all buffered records
+  hsize_t newSize = m_size + m_count;
+  m_ds.resize(newSize);
+
+  // select the whole range in a file and write it
+  DataSpace fileDsp = m_ds.dataSpace();
+  hsize_t start[] = { m_size };
+  hsize_t count[] = { m_count };
+  fileDsp.select_hyperslab(H5S_SELECT_SET, start, 0, count, 0);
+  DataSpace memDsp = DataSpace::makeSimple(m_count, m_count);
+  m_ds.store(memDsp, fileDsp, static_cast<const void*>(&m_buffer.front()), m_type);
+
+  m_size = newSize;
+  m_count = 0;
+  m_limit = m_bufSize;
+}
+
+//----------------
+// Constructors --
+//----------------
+DataSetAppender::DataSetAppender(const DataSet& ds, const Type& native_type, hsize_t bufSize)
+  : m_impl(new Impl(ds, native_type, bufSize))
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+DataSetAppender::~DataSetAppender()
+{
+}
+
+// Add one record to the end of dataset.
+void
+DataSetAppender::append(const void* data)
+{
+  m_impl->append(data);
+}
+
+// Write all buffered records to a dataset.
+void
+DataSetAppender::flush()
+{
+  m_impl->flush();
+}
+
+// Get dataset size including records which are still in buffer
+hsize_t
+DataSetAppender::size() const
+{
+  return m_impl->m_size + m_impl->m_count;
+}
+
+// Get number of records in buffer which have not been written yet
+hsize_t
+DataSetAppender::buffered() const
+{
+  return m_impl->m_count;
+}
+
+// Get dataset object
+DataSet
+DataSetAppender::dataSet() const
+{
+  return m_impl->m_ds;
+}
+
+} // namespace hdf5pp
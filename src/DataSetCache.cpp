@@ -0,0 +1,221 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class DataSetCache...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/DataSetCache.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.DataSetCache";
+
+  size_t g_defCapacity = 1024;
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+//----------------
+// Constructors --
+//----------------
+DataSetCache::DataSetCache(size_t capacity)
+  : m_mutex()
+  , m_capacity(capacity ? capacity : g_defCapacity)
+  , m_lru()
+  , m_index()
+  , m_scanAt(0)
+  , m_hits(0)
+  , m_misses(0)
+  , m_evictions(0)
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+DataSetCache::~DataSetCache()
+{
+}
+
+// Find dataset in cache.
+DataSet
+DataSetCache::find(const std::string& path)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  Index::const_iterator it = m_index.find(path);
+  if (it == m_index.end()) {
+    ++ m_misses;
+    return DataSet();
+  }
+
+  ++ m_hits;
+  m_lru.splice(m_lru.begin(), m_lru, it->second);
+  return it->second->second;
+}
+
+// Check whether dataset is in cache.
+bool
+DataSetCache::contains(const std::string& path) const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_index.find(path) != m_index.end();
+}
+
+// Add dataset to the cache, least recently used datasets may be evicted.
+void
+DataSetCache::insert(const std::string& path, const DataSet& ds)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  Index::iterator it = m_index.find(path);
+  if (it != m_index.end()) {
+    it->second->second = ds;
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+  } else {
+    m_lru.push_front(std::make_pair(path, ds));
+    m_index.insert(std::make_pair(path, m_lru.begin()));
+    _evict();
+  }
+}
+
+// Remove dataset from the cache.
+void
+DataSetCache::erase(const std::string& path)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  Index::iterator it = m_index.find(path);
+  if (it != m_index.end()) {
+    m_lru.erase(it->second);
+    m_index.erase(it);
+  }
+}
+
+// Remove all datasets from the cache.
+void
+DataSetCache::clear()
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_index.clear();
+  m_lru.clear();
+  m_scanAt = 0;
+}
+
+// Get maximum number of open handles.
+size_t
+DataSetCache::capacity() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_capacity;
+}
+
+// Change maximum number of open handles, evicts datasets if necessary.
+void
+DataSetCache::setCapacity(size_t capacity)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_capacity = capacity ? capacity : g_defCapacity;
+  m_scanAt = 0;
+  _evict();
+}
+
+// Get number of datasets in cache.
+size_t
+DataSetCache::size() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_index.size();
+}
+
+// Get number of lookups which found dataset in cache.
+unsigned long
+DataSetCache::hits() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_hits;
+}
+
+// Get number of lookups which did not find dataset in cache.
+unsigned long
+DataSetCache::misses() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_misses;
+}
+
+// Get number of datasets evicted from cache.
+unsigned long
+DataSetCache::evictions() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_evictions;
+}
+
+// Set capacity of caches made for files opened after this call.
+void
+DataSetCache::setDefaultCapacity(size_t capacity)
+{
+  if (capacity) g_defCapacity = capacity;
+}
+
+// Get capacity of caches made for new files.
+size_t
+DataSetCache::defaultCapacity()
+{
+  return g_defCapacity;
+}
+
+// evict least recently used datasets which are not pinned
+void
+DataSetCache::_evict()
+{
+  if (m_index.size() <= m_capacity or m_index.size() < m_scanAt) return;
+
+  // pinned datasets stay where they are, scan goes from the least recently
+  // used end and skips them
+  size_t npinned = 0;
+  LruList::iterator it = m_lru.end();
+  while (m_index.size() > m_capacity and it != m_lru.begin()) {
+    -- it;
+    if (it->second._pinned()) {
+      ++ npinned;
+    } else {
+      MsgLog(logger, debug, "DataSetCache: evict dataset " << it->first);
+      LruList::iterator victim = it ++;
+      m_index.erase(victim->first);
+      m_lru.erase(victim);
+      ++ m_evictions;
+    }
+  }
+
+  // if everything left is pinned then next scan waits until as many
+  // datasets are added as were skipped, so inserts stay amortized O(1)
+  m_scanAt = m_index.size() > m_capacity ? m_index.size() + npinned : 0;
+}
+
+} // namespace hdf5pp
@@ -0,0 +1,308 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class DataSetReader...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/DataSetReader.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/DataSpace.h"
+#include "hdf5pp/Exceptions.h"
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.DataSetReader";
+
+  // window size for non-chunked datasets
+  const hsize_t defWindow = 1024;
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Implementation is shared between all copies of the reader.
+struct DataSetReader::Impl {
+
+  // range of records in memory
+  struct Window {
+    Window() : start(0), count(0) {}
+    bool contains(hsize_t index) const { return index >= start and index < start + count; }
+    hsize_t start;              ///< Index of first record
+    hsize_t count;              ///< Number of records, 0 if window is empty
+    std::vector<char> data;     ///< Records
+  };
+
+  Impl(const DataSet& ds, const Type& native_type, hsize_t window, bool background);
+  ~Impl();
+
+  const void* get(hsize_t index);
+
+  // read range of records into a window
+  void load(Window& w, hsize_t start, hsize_t count);
+
+  // release VLEN data and make window empty
+  void clear(Window& w);
+
+  // start reading next window in background thread
+  void startPrefetch(hsize_t start);
+
+  // wait for background thread to finish
+  void waitPrefetch();
+
+  // runs in background thread
+  void prefetch(Window* w, hsize_t start, hsize_t count);
+
+  DataSet m_ds;               ///< Dataset to read from
+  Type m_type;                ///< In-memory type of records
+  size_t m_recSize;           ///< Size of one record in memory
+  bool m_vlen;                ///< True if records contain VLEN data
+  hsize_t m_window;           ///< Window size in records
+  bool m_background;          ///< True if background prefetch is enabled
+  hsize_t m_size;             ///< Dataset size
+  hsize_t m_last;             ///< Last requested index
+  bool m_sequential;          ///< True if last request followed previous one
+  unsigned long m_reads;      ///< Number of H5Dread calls
+  Window m_windows[2];        ///< Current window and prefetched/previous window
+  unsigned m_cur;             ///< Index of current window
+  boost::thread m_thread;     ///< Background prefetch thread
+};
+
+DataSetReader::Impl::Impl(const DataSet& ds, const Type& native_type, hsize_t window, bool background)
+  : m_ds(ds)
+  , m_type(native_type)
+  , m_recSize(native_type.size())
+  , m_vlen(false)
+  , m_window(window)
+  , m_background(background)
+  , m_size(0)
+  , m_last(hsize_t(-1))
+  , m_sequential(false)
+  , m_reads(0)
+  , m_cur(0)
+  , m_thread()
+{
+  unsigned rank = m_ds.dataSpace().rank();
+  if (rank != 1) throw Hdf5RankMismatch(ERR_LOC, 1, rank);
+  m_size = m_ds.size();
+
+  htri_t vlen = H5Tdetect_class(m_type.id(), H5T_VLEN);
+  if (vlen < 0) throw Hdf5CallException( ERR_LOC, "H5Tdetect_class" ) ;
+  m_vlen = vlen > 0 or (m_type.tclass() == H5T_STRING and H5Tis_variable_str(m_type.id()) > 0);
+
+  if (m_window == 0) {
+    hid_t plist = H5Dget_create_plist(m_ds.id());
+    if (plist < 0) throw Hdf5CallException( ERR_LOC, "H5Dget_create_plist" ) ;
+    H5D_layout_t layout = H5Pget_layout(plist);
+    H5Pclose(plist);
+    m_window = layout == H5D_CHUNKED ? m_ds.chunkSize() : defWindow;
+  }
+
+  if (m_background) {
+    hbool_t threadsafe = 0;
+#if H5_VERSION_GE(1,8,16)
+    if (H5is_library_threadsafe(&threadsafe) < 0) threadsafe = 0;
+#endif
+    if (not threadsafe) {
+      MsgLog(logger, debug, "DataSetReader: HDF5 library is not thread-safe, background prefetch is disabled");
+      m_background = false;
+    }
+  }
+
+  MsgLog(logger, debug, "DataSetReader: dataset=" << m_ds.name() << " size=" << m_size
+         << " window=" << m_window << " background=" << m_background);
+}
+
+DataSetReader::Impl::~Impl()
+{
+  // cannot let exceptions escape from destructor
+  try {
+    waitPrefetch();
+    clear(m_windows[0]);
+    clear(m_windows[1]);
+  } catch (const std::exception& ex) {
+    MsgLog(logger, error, "DataSetReader: failed to release data: " << ex.what());
+  }
+}
+
+const void*
+DataSetReader::Impl::get(hsize_t index)
+{
+  if (index >= m_size) {
+    // dataset may have grown
+    m_size = m_ds.size();
+    if (index >= m_size) {
+      throw Exception(ERR_LOC, "DataSetReader", "index is out of range for dataset " + m_ds.name());
+    }
+  }
+
+  if (not m_windows[m_cur].contains(index)) {
+
+    m_sequential = index == m_last + 1;
+
+    waitPrefetch();
+    Window& other = m_windows[1 - m_cur];
+    if (other.contains(index)) {
+      // prefetched or previous window
+      m_cur = 1 - m_cur;
+    } else if (m_sequential) {
+      // read whole window aligned on window boundary
+      hsize_t start = index - index % m_window;
+      load(m_windows[m_cur], start, std::min(m_window, m_size - start));
+      ++ m_reads;
+    } else {
+      // random access, read single record
+      load(m_windows[m_cur], index, 1);
+      ++ m_reads;
+    }
+
+    // when reading sequentially get next window ready
+    const Window& cur = m_windows[m_cur];
+    hsize_t next = cur.start + cur.count;
+    if (m_background and m_sequential and cur.count > 1 and next < m_size
+        and not m_windows[1 - m_cur].contains(next)) {
+      startPrefetch(next);
+    }
+  }
+
+  m_last = index;
+  const Window& cur = m_windows[m_cur];
+  return &cur.data[(index - cur.start) * m_recSize];
+}
+
+void
+DataSetReader::Impl::load(Window& w, hsize_t start, hsize_t count)
+{
+  clear(w);
+
+  w.data.resize(count * m_recSize);
+  DataSpace fileDsp = m_ds.dataSpace();
+  hsize_t offset[] = { start };
+  hsize_t dims[] = { count };
+  fileDsp.select_hyperslab(H5S_SELECT_SET, offset, 0, dims, 0);
+  DataSpace memDsp = DataSpace::makeSimple(count, count);
+  m_ds.read(memDsp, fileDsp, &w.data.front(), m_type);
+
+  w.start = start;
+  w.count = count;
+}
+
+void
+DataSetReader::Impl::clear(Window& w)
+{
+  if (m_vlen and w.count > 0) {
+    DataSpace memDsp = DataSpace::makeSimple(w.count, w.count);
+    herr_t stat = H5Dvlen_reclaim(m_type.id(), memDsp.id(), H5P_DEFAULT, &w.data.front());
+    if ( stat < 0 ) throw Hdf5CallException( ERR_LOC, "H5Dvlen_reclaim" ) ;
+  }
+  w.count = 0;
+}
+
+void
+DataSetReader::Impl::startPrefetch(hsize_t start)
+{
+  hsize_t count = std::min(m_window, m_size - start);
+  // window is marked empty until thread finishes
+  Window* w = &m_windows[1 - m_cur];
+  clear(*w);
+  boost::thread thread(boost::bind(&Impl::prefetch, this, w, start, count));
+  m_thread.swap(thread);
+  ++ m_reads;
+}
+
+void
+DataSetReader::Impl::waitPrefetch()
+{
+  if (m_thread.joinable()) m_thread.join();
+}
+
+void
+DataSetReader::Impl::prefetch(Window* w, hsize_t start, hsize_t count)
+{
+  // on failure window stays empty, next get() will read it again and report error
+  try {
+    load(*w, start, count);
+  } catch (const std::exception& ex) {
+    MsgLog(logger, debug, "DataSetReader: prefetch failed: " << ex.what());
+    w->count = 0;
+  }
+}
+
+//----------------
+// Constructors --
+//----------------
+DataSetReader::DataSetReader(const DataSet& ds, const Type& native_type, hsize_t window, bool background)
+  : m_impl(new Impl(ds, native_type, window, background))
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+DataSetReader::~DataSetReader()
+{
+}
+
+// Get pointer to a record.
+const void*
+DataSetReader::get(hsize_t index)
+{
+  return m_impl->get(index);
+}
+
+// Copy one record to a caller-provided location.
+void
+DataSetReader::read(hsize_t index, void* data)
+{
+  std::memcpy(data, m_impl->get(index), m_impl->m_recSize);
+}
+
+// Get number of records in a dataset
+hsize_t
+DataSetReader::size() const
+{
+  return m_impl->m_size;
+}
+
+// Get number of H5Dread() calls made so far
+unsigned long
+DataSetReader::reads() const
+{
+  return m_impl->m_reads;
+}
+
+// Get dataset object
+DataSet
+DataSetReader::dataSet() const
+{
+  return m_impl->m_ds;
+}
+
+} // namespace hdf5pp
@@ -19,11 +19,13 @@
 // C/C++ Headers --
 //-----------------
 #include <sstream>
+#include <boost/make_shared.hpp>
 
 //-------------------------------
 // Collaborating Class Headers --
 //-------------------------------
 #include "hdf5pp/Exceptions.h"
+#include "hdf5pp/FileIndex.h"
 
 //-----------------------------------------------------------------------
 // Local Macros, Typedefs, Structures, Unions and Forward Declarations --
@@ -64,11 +66,17 @@ namespace hdf5pp {
 //----------------
 File::File ()
   : m_id ()
+  , m_dsCache ()
+  , m_pathCache ()
+  , m_catalog ()
 {
 }
 
 File::File ( hid_t id )
   : m_id ( new hid_t(id), FilePtrDeleter() )
+  , m_dsCache ( boost::make_shared<DataSetCache>() )
+  , m_pathCache ( boost::make_shared<PathCache>() )
+  , m_catalog ()
 {
 }
 
@@ -115,13 +123,23 @@ File::open( const std::string& path,
     callMsg << "H5Fopen path=" << path <<" mode=" << OpenMode2str(mode);
     throw Hdf5CallException( ERR_LOC, callMsg.str()) ;
   }
-  return File(f_id) ;
+  File file(f_id) ;
+
+  // files which are not modified can use their index, path cache looks
+  // up objects in it on demand; index which does not match the file or
+  // cannot be read is ignored
+  if ( mode == Read and FileIndex::read(path, file.m_catalog) ) {
+    file.m_pathCache->setCatalog(file.m_catalog);
+  }
+
+  return file ;
 }
 
 // close the file
 void
 File::close()
 {
+  if (m_dsCache) m_dsCache->clear();
   m_id.reset();
 }
 
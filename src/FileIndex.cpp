@@ -0,0 +1,138 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class FileIndex...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/FileIndex.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <sys/stat.h>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Exceptions.h"
+#include "hdf5pp/File.h"
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.FileIndex";
+
+  // state of a file used to validate index
+  struct Stamp {
+    uint64_t size;
+    int64_t mtime;
+    int64_t mtimeNsec;
+  };
+
+  // get state of a file, returns false if file does not exist
+  bool getStamp(const std::string& path, Stamp& stamp)
+  {
+    struct stat st;
+    if (stat(path.c_str(), &st) < 0) return false;
+    std::memset(&stamp, 0, sizeof stamp);
+    stamp.size = st.st_size;
+    stamp.mtime = st.st_mtime;
+#if defined(__APPLE__)
+    stamp.mtimeNsec = st.st_mtimespec.tv_nsec;
+#else
+    stamp.mtimeNsec = st.st_mtim.tv_nsec;
+#endif
+    return true;
+  }
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Scan file and write its index.
+Catalog
+FileIndex::create(const std::string& path)
+{
+  // stamp is taken before scanning, if file changes while it is
+  // scanned then index will not match it
+  Stamp stamp;
+  if (not getStamp(path, stamp)) {
+    throw Exception(ERR_LOC, "FileIndex", "cannot stat file " + path + ": " + std::strerror(errno));
+  }
+
+  Catalog catalog = Catalog::scan(File::open(path, File::Read));
+
+  const std::string& idxPath = indexPath(path);
+  std::ostringstream tmpPath;
+  tmpPath << idxPath << ".tmp." << getpid();
+  {
+    std::ofstream out(tmpPath.str().c_str(), std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&stamp), sizeof stamp);
+    catalog.write(out);
+    out.close();
+    if (not out) {
+      std::remove(tmpPath.str().c_str());
+      throw Exception(ERR_LOC, "FileIndex", "failed to write index file " + tmpPath.str());
+    }
+  }
+  if (std::rename(tmpPath.str().c_str(), idxPath.c_str()) != 0) {
+    std::remove(tmpPath.str().c_str());
+    throw Exception(ERR_LOC, "FileIndex", "failed to rename index file to " + idxPath);
+  }
+
+  MsgLog(logger, debug, "FileIndex::create: file=" << path << " objects=" << catalog.size());
+  return catalog;
+}
+
+// Read index of a file.
+bool
+FileIndex::read(const std::string& path, Catalog& catalog)
+{
+  catalog = Catalog();
+
+  Stamp stamp;
+  if (not getStamp(path, stamp)) return false;
+
+  const std::string& idxPath = indexPath(path);
+  std::ifstream in(idxPath.c_str(), std::ios::binary);
+  if (not in) return false;
+
+  Stamp idxStamp;
+  in.read(reinterpret_cast<char*>(&idxStamp), sizeof idxStamp);
+  if (not in or std::memcmp(&stamp, &idxStamp, sizeof stamp) != 0) {
+    MsgLog(logger, debug, "FileIndex::read: index " << idxPath << " does not match file");
+    return false;
+  }
+
+  // index is not trusted, Catalog::read() validates it
+  try {
+    catalog = Catalog::read(in);
+  } catch (const std::exception& ex) {
+    MsgLog(logger, warning, "FileIndex::read: ignoring damaged index " << idxPath << ": " << ex.what());
+    catalog = Catalog();
+    return false;
+  }
+  return true;
+}
+
+} // namespace hdf5pp
@@ -0,0 +1,199 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class FilterPipeline...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/FilterPipeline.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <algorithm>
+#include <cstring>
+#include <zlib.h>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Exceptions.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  // same transformation as done by H5Z shuffle filter
+  void shuffle(const char* src, size_t size, size_t elemSize, std::vector<char>& out)
+  {
+    out.resize(size);
+    size_t nelem = size / elemSize;
+    if (elemSize > 1 and nelem > 1) {
+      char* dst = &out.front();
+      for (size_t j = 0; j != elemSize; ++ j) {
+        const char* s = src + j;
+        for (size_t i = 0; i != nelem; ++ i, s += elemSize) *dst++ = *s;
+      }
+      // leftover bytes are copied as is
+      std::memcpy(dst, src + nelem*elemSize, size - nelem*elemSize);
+    } else if (size > 0) {
+      std::memcpy(&out.front(), src, size);
+    }
+  }
+
+  // same transformation as done by H5Z deflate filter, returns false on failure
+  bool deflate(const char* src, size_t size, int level, std::vector<char>& out)
+  {
+    uLongf dstSize = compressBound(size);
+    out.resize(dstSize);
+    int stat = compress2(reinterpret_cast<Bytef*>(&out.front()), &dstSize,
+        reinterpret_cast<const Bytef*>(src), size, level);
+    if (stat != Z_OK) return false;
+    out.resize(dstSize);
+    return true;
+  }
+
+  // reverse of shuffle()
+  void unshuffle(const char* src, size_t size, size_t elemSize, std::vector<char>& out)
+  {
+    out.resize(size);
+    size_t nelem = size / elemSize;
+    if (elemSize > 1 and nelem > 1) {
+      char* dst = &out.front();
+      for (size_t j = 0; j != elemSize; ++ j) {
+        char* d = dst + j;
+        for (size_t i = 0; i != nelem; ++ i, d += elemSize) *d = *src++;
+      }
+      std::memcpy(dst + nelem*elemSize, src, size - nelem*elemSize);
+    } else if (size > 0) {
+      std::memcpy(&out.front(), src, size);
+    }
+  }
+
+  // reverse of deflate(), returns false on failure
+  bool inflate(const char* src, size_t size, size_t outSize, std::vector<char>& out)
+  {
+    uLongf dstSize = outSize;
+    out.resize(dstSize);
+    int stat = uncompress(reinterpret_cast<Bytef*>(&out.front()), &dstSize,
+        reinterpret_cast<const Bytef*>(src), size);
+    if (stat != Z_OK) return false;
+    out.resize(dstSize);
+    return true;
+  }
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Make pipeline from dataset filters.
+FilterPipeline::FilterPipeline(const DataSet& ds)
+  : m_filters()
+{
+  hid_t plist = H5Dget_create_plist(ds.id());
+  if (plist < 0) throw Hdf5CallException( ERR_LOC, "H5Dget_create_plist" ) ;
+
+  int nfilters = H5Pget_nfilters(plist);
+  for (int i = 0; i < nfilters; ++ i) {
+    Filter filter;
+    size_t nelmts = 8;
+    filter.cd_values.resize(nelmts);
+    filter.id = H5Pget_filter2(plist, i, &filter.flags, &nelmts, &filter.cd_values.front(), 0, 0, 0);
+    if (filter.id < 0) {
+      H5Pclose(plist);
+      throw Hdf5CallException( ERR_LOC, "H5Pget_filter2" ) ;
+    }
+    filter.cd_values.resize(std::min(nelmts, filter.cd_values.size()));
+    m_filters.push_back(filter);
+  }
+  H5Pclose(plist);
+}
+
+// Returns true if all filters in the pipeline are supported
+bool
+FilterPipeline::supported() const
+{
+  for (std::vector<Filter>::const_iterator it = m_filters.begin(); it != m_filters.end(); ++ it) {
+    if (it->id == H5Z_FILTER_SHUFFLE and not it->cd_values.empty()) continue;
+    if (it->id == H5Z_FILTER_DEFLATE and not it->cd_values.empty()) continue;
+    return false;
+  }
+  return true;
+}
+
+// Apply filters to chunk data.
+uint32_t
+FilterPipeline::encode(const void* data, size_t size, std::vector<char>& out) const
+{
+  uint32_t mask = 0;
+
+  out.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+  std::vector<char> tmp;
+  for (unsigned i = 0; i != m_filters.size(); ++ i) {
+    const Filter& filter = m_filters[i];
+    const char* src = out.empty() ? 0 : &out.front();
+    bool ok = false;
+    if (filter.id == H5Z_FILTER_SHUFFLE and not filter.cd_values.empty()) {
+      shuffle(src, out.size(), filter.cd_values[0], tmp);
+      ok = true;
+    } else if (filter.id == H5Z_FILTER_DEFLATE and not filter.cd_values.empty()) {
+      ok = deflate(src, out.size(), filter.cd_values[0], tmp);
+    } else {
+      throw Exception(ERR_LOC, "FilterPipeline", "unsupported filter id "
+          + boost::lexical_cast<std::string>(filter.id));
+    }
+    if (ok) {
+      out.swap(tmp);
+    } else if (filter.flags & H5Z_FLAG_OPTIONAL) {
+      mask |= 1u << i;
+    } else {
+      throw Exception(ERR_LOC, "FilterPipeline", "filter failed, filter id "
+          + boost::lexical_cast<std::string>(filter.id));
+    }
+  }
+
+  return mask;
+}
+
+// Undo filters applied to chunk data.
+void
+FilterPipeline::decode(const void* data, size_t size, uint32_t filterMask, size_t chunkSize,
+    std::vector<char>& out) const
+{
+  out.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+  std::vector<char> tmp;
+  for (unsigned i = m_filters.size(); i-- != 0; ) {
+    if (filterMask & (1u << i)) continue;
+    const Filter& filter = m_filters[i];
+    const char* src = out.empty() ? 0 : &out.front();
+    if (filter.id == H5Z_FILTER_SHUFFLE and not filter.cd_values.empty()) {
+      unshuffle(src, out.size(), filter.cd_values[0], tmp);
+    } else if (filter.id == H5Z_FILTER_DEFLATE and not filter.cd_values.empty()) {
+      if (not inflate(src, out.size(), chunkSize, tmp)) {
+        throw Exception(ERR_LOC, "FilterPipeline", "failed to decompress chunk data");
+      }
+    } else {
+      throw Exception(ERR_LOC, "FilterPipeline", "unsupported filter id "
+          + boost::lexical_cast<std::string>(filter.id));
+    }
+    out.swap(tmp);
+  }
+
+  if (out.size() != chunkSize) {
+    throw Exception(ERR_LOC, "FilterPipeline", "unexpected size of decoded chunk "
+        + boost::lexical_cast<std::string>(out.size()));
+  }
+}
+
+} // namespace hdf5pp
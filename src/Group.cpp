@@ -18,7 +18,6 @@
 //-----------------
 // C/C++ Headers --
 //-----------------
-#include <boost/make_shared.hpp>
 
 //-------------------------------
 // Collaborating Class Headers --
@@ -56,9 +55,12 @@ namespace hdf5pp {
 //----------------
 // Constructors --
 //----------------
-Group::Group ( hid_t grp )
+Group::Group ( hid_t grp, const boost::shared_ptr<DataSetCache>& dsCache,
+    const boost::shared_ptr<PathCache>& pathCache, const std::string& path )
   : m_id( new hid_t(grp), ::GroupPtrDeleter() )
-  , m_dsCache(boost::make_shared<DsCache>())
+  , m_dsCache(dsCache)
+  , m_pathCache(pathCache)
+  , m_path(path)
 {
   MsgLog(logger, debug, "Group ctor: " << *this) ;
 }
@@ -72,29 +74,56 @@ Group::~Group ()
 
 // factory methods
 Group
-Group::createGroup ( hid_t parent, const std::string& name )
+Group::createGroup ( hid_t loc, const std::string& path,
+    const boost::shared_ptr<DataSetCache>& dsCache, const boost::shared_ptr<PathCache>& pathCache )
 {
-  MsgLog(logger, debug, "Group::createGroup: parent=" << parent << " name=" << name ) ;
+  MsgLog(logger, debug, "Group::createGroup: loc=" << loc << " path=" << path ) ;
   // allow creation of intermediate directories
   hid_t lcpl_id = H5Pcreate( H5P_LINK_CREATE ) ;
   H5Pset_create_intermediate_group( lcpl_id, 1 ) ;
-  hid_t f_id = H5Gcreate2 ( parent, name.c_str(), lcpl_id, H5P_DEFAULT, H5P_DEFAULT ) ;
+  hid_t f_id = H5Gcreate2 ( loc, path.c_str(), lcpl_id, H5P_DEFAULT, H5P_DEFAULT ) ;
   H5Pclose( lcpl_id ) ;
   if ( f_id < 0 ) {
     throw Hdf5CallException( ERR_LOC, "H5Gcreate2") ;
   }
-  return Group(f_id) ;
+  pathCache->invalidate();
+  return Group(f_id, dsCache, pathCache, path) ;
 }
 
 Group
-Group::openGroup ( hid_t parent, const std::string& name )
+Group::openGroup ( hid_t loc, const std::string& path,
+    const boost::shared_ptr<DataSetCache>& dsCache, const boost::shared_ptr<PathCache>& pathCache )
 {
-  MsgLog(logger, debug, "Group::openGroup: parent=" << parent << " name=" << name ) ;
-  hid_t f_id = H5Gopen2 ( parent, name.c_str(), H5P_DEFAULT ) ;
+  MsgLog(logger, debug, "Group::openGroup: loc=" << loc << " path=" << path ) ;
+
+  // groups which were opened before are reopened by token
+  PathCache::Entry entry;
+  PathCache::Status status = pathCache->find(path, entry);
+  if (status == PathCache::Missing) {
+    throw Hdf5CallException( ERR_LOC, "H5Gopen2") ;
+  }
+  if (status == PathCache::Exists and entry.type == H5O_TYPE_GROUP) {
+    // token which does not point to a group (e.g. from outdated index)
+    // is replaced by opening group by its path
+    hid_t id = -1;
+    H5E_BEGIN_TRY {
+      try {
+        id = PathCache::open(loc, entry);
+      } catch (const Hdf5CallException&) {
+      }
+    } H5E_END_TRY;
+    if (id >= 0 and H5Iget_type(id) == H5I_GROUP) return Group(id, dsCache, pathCache, path) ;
+    if (id >= 0) H5Oclose(id);
+    MsgLog(logger, warning, "Group::openGroup: cached token is not valid for " << path) ;
+  }
+
+  hid_t f_id = H5Gopen2 ( loc, path.c_str(), H5P_DEFAULT ) ;
   if ( f_id < 0 ) {
     throw Hdf5CallException( ERR_LOC, "H5Gopen2") ;
   }
-  return Group(f_id) ;
+  Group grp(f_id, dsCache, pathCache, path) ;
+  pathCache->insert(path, PathCache::objectInfo(f_id));
+  return grp;
 }
 
 bool
@@ -105,27 +134,36 @@ Group::hasChild ( const std::string& name ) const
   std::string child = name;
   std::string::size_type p = name.find('/');
   if (p != std::string::npos) {
+    // check and open intermediate group, both are resolved from cache if possible
     child.erase(p);
-  } else {
-    // small optimization, if this is the last item in the path check cached datasets first
-    DsCache::const_iterator it = m_dsCache->find(child);
-    if (it != m_dsCache->end()) return true;
+    if (not hasChild(child)) return false;
+    return openGroup(child).hasChild(std::string(name, p+1));
+  }
+
+  // try cached paths first
+  const std::string& path = _path(child);
+  PathCache::Entry entry;
+  PathCache::Status status = m_pathCache->find(path, entry);
+  if (status != PathCache::Unknown) return status == PathCache::Exists;
+
+  // small optimization, if this is the last item in the path check cached datasets first
+  if (m_dsCache->contains(path)) {
+    m_pathCache->insert(path);
+    return true;
   }
 
   // check that the link exists
   hid_t lapl_id = H5Pcreate( H5P_LINK_ACCESS ) ;
   htri_t stat = H5Lexists ( *m_id, child.c_str(), lapl_id ) ;
   H5Pclose( lapl_id ) ;
-  if (p == std::string::npos) return stat>0 ;
+  if (stat < 0) return false;
 
-  if (stat <= 0) return false;
-  
-  // open child group
-  hid_t f_id = H5Gopen2 ( *m_id, child.c_str(), H5P_DEFAULT ) ;
-  if ( f_id < 0 ) {
-    throw Hdf5CallException( ERR_LOC, "H5Gopen2") ;
+  if (stat > 0) {
+    m_pathCache->insert(path);
+  } else {
+    m_pathCache->insertMissing(path);
   }
-  return Group(f_id).hasChild(std::string(name, p+1));
+  return stat > 0 ;
 }
 
 // get parent for this group, returns non-valid object if no parent group exists
@@ -137,21 +175,23 @@ Group::parent() const
   std::string path = name();
   if (path.empty() or path == "/") return Group();
 
+  // parent of top-level group is root group
   std::string::size_type p = path.rfind('/');
-  if (p != std::string::npos) path.erase(p);
+  if (p != std::string::npos) path.erase(p == 0 ? 1 : p);
 
-  return openGroup(*m_id, path);
+  return openGroup(*m_id, path, m_dsCache, m_pathCache);
 }
 
 // open existing data set
 DataSet
 Group::openDataSet (const std::string& name, const PListDataSetAccess& plistDSaccess) const
 {
-  DsCache::const_iterator it = m_dsCache->find(name);
-  if (it != m_dsCache->end()) return it->second;
+  const std::string& path = _path(name);
+  DataSet res = m_dsCache->find(path);
+  if (res.valid()) return res;
 
-  DataSet res = DataSet::openDataSet ( *m_id, name, plistDSaccess ) ;
-  m_dsCache->insert(std::make_pair(name, res));
+  res = DataSet::openDataSet ( *m_id, name, plistDSaccess ) ;
+  m_dsCache->insert(path, res);
 
   return res;
 }
@@ -164,6 +204,7 @@ Group::makeSoftLink(const std::string& targetPath, const std::string& linkName)
   if ( err < 0 ) {
     throw Hdf5CallException( ERR_LOC, "H5Lcreate_soft") ;
   }
+  m_pathCache->invalidate();
 }
 
 // Get link type.
@@ -220,6 +261,8 @@ Group::close()
 std::string 
 Group::name() const
 {
+  if (not m_path.empty()) return m_path;
+
   const int maxsize = 255;
   char buf[maxsize+1];
 
@@ -255,6 +298,29 @@ Group::basename() const
   return std::string(path, p+1);
 }
 
+// absolute path of a dataset
+std::string
+Group::_path(const std::string& name) const
+{
+  if (not name.empty() and name[0] == '/') return _normalize(name);
+  return _normalize(this->name() + '/' + name);
+}
+
+// collapse repeated slashes and strip trailing slash, so that the same
+// object always has the same path in caches
+std::string
+Group::_normalize(const std::string& path)
+{
+  std::string res;
+  res.reserve(path.size());
+  for (std::string::const_iterator it = path.begin(); it != path.end(); ++ it) {
+    if (*it == '/' and not res.empty() and res[res.size()-1] == '/') continue;
+    res += *it;
+  }
+  if (res.size() > 1 and res[res.size()-1] == '/') res.erase(res.size()-1);
+  return res;
+}
+
 // groups can be used as keys for associative containers, need compare operators
 bool
 Group::operator<( const Group& other ) const
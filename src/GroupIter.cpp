@@ -18,6 +18,7 @@
 //-----------------
 // C/C++ Headers --
 //-----------------
+#include <boost/make_shared.hpp>
 
 //-------------------------------
 // Collaborating Class Headers --
@@ -40,15 +41,9 @@ namespace hdf5pp {
 GroupIter::GroupIter (const Group& group, LinkType type)
   : m_group(group)
   , m_type(type)
-  , m_nlinks(0) 
+  , m_entries(LinkEntry::list(group))
   , m_idx(0)
 {
-  // get the number of links in a group
-  H5G_info_t g_info;
-  if (H5Gget_info(m_group.id(), &g_info) < 0) {
-    throw Hdf5CallException( ERR_LOC, "H5Gget_info") ;
-  }
-  m_nlinks = g_info.nlinks;
 }
 
 //--------------
@@ -63,33 +58,42 @@ Group
 GroupIter::next()
 {
   Group grp;  
-  for (; not grp.valid() and m_idx < m_nlinks; ++ m_idx) {
+  for (; not grp.valid() and m_idx < m_entries.size(); ++ m_idx) {
 
+    const LinkEntry& entry = m_entries[m_idx];
     if (m_type != Any) {
       // test for link type
-      H5L_info_t linfo;
-      herr_t err = H5Lget_info_by_idx(m_group.id(), ".", H5_INDEX_NAME, H5_ITER_NATIVE, m_idx, &linfo, H5P_DEFAULT);
-      if (err < 0) {
-        throw Hdf5CallException( ERR_LOC, "H5Lget_info_by_idx") ;
-      }
-      if (not (linfo.type == H5L_TYPE_SOFT and int(m_type) & int(SoftLink)) and
-          not (linfo.type == H5L_TYPE_HARD and int(m_type) & int(HardLink))) continue;
-    }
-    
-    // open object
-    hid_t hid = H5Oopen_by_idx(m_group.id(), ".", H5_INDEX_NAME, H5_ITER_NATIVE, m_idx, H5P_DEFAULT);
-    if (hid < 0) {
-      throw Hdf5CallException( ERR_LOC, "H5Oopen_by_idx") ;
+      if (not (entry.linkType == H5L_TYPE_SOFT and int(m_type) & int(SoftLink)) and
+          not (entry.linkType == H5L_TYPE_HARD and int(m_type) & int(HardLink))) continue;
     }
 
-    // only care about groups
-    if (H5Iget_type(hid) != H5I_GROUP) {
-      H5Oclose(hid);
-      continue;
-    }
+    const std::string& path = m_group._path(entry.name);
+    if (entry.objType == H5O_TYPE_GROUP) {
+
+      // open group by its token and remember it
+      PathCache::Entry pentry;
+      pentry.type = entry.objType;
+      pentry.token = entry.token;
+      grp = Group(PathCache::open(m_group.id(), pentry), m_group.m_dsCache, m_group.m_pathCache, path);
+      m_group.m_pathCache->insert(path, pentry);
 
-    // make a group object and return
-    grp = Group(hid);
+    } else if (entry.linkType == H5L_TYPE_EXTERNAL) {
+
+      // type of external objects is not known, need to open them
+      hid_t hid = H5Oopen(m_group.id(), entry.name.c_str(), H5P_DEFAULT);
+      if (hid < 0) {
+        throw Hdf5CallException( ERR_LOC, "H5Oopen") ;
+      }
+      if (H5Iget_type(hid) != H5I_GROUP) {
+        H5Oclose(hid);
+        continue;
+      }
+      // group lives in other file, its paths and tokens must not be mixed
+      // with caches of this file, name is the path in that file
+      grp = Group(hid, boost::make_shared<DataSetCache>(m_group.m_dsCache->capacity()),
+                  boost::make_shared<PathCache>());
+
+    }
   }
   
   // Done iterating
@@ -0,0 +1,117 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class LinkEntry...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/LinkEntry.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Exceptions.h"
+#include "hdf5pp/Group.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  // get type and token of the object which link points to, fails for
+  // dangling soft links, error stack is not printed for those
+  herr_t objectInfo(hid_t group, const char* name, hdf5pp::LinkEntry& entry)
+  {
+    herr_t stat;
+#if H5_VERSION_GE(1,12,0)
+    H5O_info2_t info;
+    H5E_BEGIN_TRY {
+      stat = H5Oget_info_by_name3(group, name, &info, H5O_INFO_BASIC, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if (stat >= 0) entry.token = info.token;
+#elif H5_VERSION_GE(1,10,3)
+    H5O_info_t info;
+    H5E_BEGIN_TRY {
+      stat = H5Oget_info_by_name2(group, name, &info, H5O_INFO_BASIC, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if (stat >= 0) entry.token = info.addr;
+#else
+    H5O_info_t info;
+    H5E_BEGIN_TRY {
+      stat = H5Oget_info_by_name(group, name, &info, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if (stat >= 0) entry.token = info.addr;
+#endif
+    if (stat >= 0) entry.objType = info.type;
+    return stat;
+  }
+
+  // H5Literate callback, collects link entries
+#if H5_VERSION_GE(1,12,0)
+  herr_t linkCallback(hid_t group, const char* name, const H5L_info2_t* linfo, void* op_data)
+#else
+  herr_t linkCallback(hid_t group, const char* name, const H5L_info_t* linfo, void* op_data)
+#endif
+  {
+    std::vector<hdf5pp::LinkEntry>& entries = *static_cast<std::vector<hdf5pp::LinkEntry>*>(op_data);
+
+    hdf5pp::LinkEntry entry;
+    entry.name = name;
+    entry.linkType = linfo->type;
+    entry.objType = H5O_TYPE_UNKNOWN;
+    entry.token = hdf5pp::PathCache::Token();
+
+    // external links are not followed, that would need opening other file
+    if (linfo->type == H5L_TYPE_HARD) {
+      if (objectInfo(group, name, entry) < 0) return -1;
+    } else if (linfo->type == H5L_TYPE_SOFT) {
+      objectInfo(group, name, entry);
+    }
+
+    entries.push_back(entry);
+    return 0;
+  }
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Get entries for all links in a group.
+std::vector<LinkEntry>
+LinkEntry::list(const Group& group)
+{
+  std::vector<LinkEntry> entries;
+
+  H5G_info_t g_info;
+  if (H5Gget_info(group.id(), &g_info) < 0) {
+    throw Hdf5CallException( ERR_LOC, "H5Gget_info") ;
+  }
+  entries.reserve(g_info.nlinks);
+
+  hsize_t idx = 0;
+#if H5_VERSION_GE(1,12,0)
+  herr_t stat = H5Literate2(group.id(), H5_INDEX_NAME, H5_ITER_NATIVE, &idx, ::linkCallback, &entries);
+  if (stat < 0) throw Hdf5CallException( ERR_LOC, "H5Literate2") ;
+#else
+  herr_t stat = H5Literate(group.id(), H5_INDEX_NAME, H5_ITER_NATIVE, &idx, ::linkCallback, &entries);
+  if (stat < 0) throw Hdf5CallException( ERR_LOC, "H5Literate") ;
+#endif
+
+  return entries;
+}
+
+} // namespace hdf5pp
@@ -40,15 +40,9 @@ namespace hdf5pp {
 NameIter::NameIter (const Group& group, LinkType type)
   : m_group(group)
   , m_type(type)
-  , m_nlinks(0) 
+  , m_entries(LinkEntry::list(group))
   , m_idx(0)
 {
-  // get the number of links in a group
-  H5G_info_t g_info;
-  if (H5Gget_info(m_group.id(), &g_info) < 0) {
-    throw Hdf5CallException( ERR_LOC, "H5Gget_info") ;
-  }
-  m_nlinks = g_info.nlinks;
 }
 
 //--------------
@@ -62,46 +56,25 @@ NameIter::~NameIter ()
 std::string 
 NameIter::next()
 {
-  const int maxsize = 255;
-  char buf[maxsize+1];
-
-  std::string result;
-  for (; result.empty() and m_idx < m_nlinks; ++ m_idx) {
+  const LinkEntry* entry = nextEntry();
+  return entry ? entry->name : std::string();
+}
 
+// Returns next link entry.
+const LinkEntry*
+NameIter::nextEntry()
+{
+  for (; m_idx < m_entries.size(); ++ m_idx) {
+    const LinkEntry& entry = m_entries[m_idx];
     if (m_type != Any) {
       // test for link type
-      H5L_info_t linfo;
-      herr_t err = H5Lget_info_by_idx(m_group.id(), ".", H5_INDEX_NAME, H5_ITER_NATIVE, m_idx, &linfo, H5P_DEFAULT);
-      if (err < 0) {
-        throw Hdf5CallException( ERR_LOC, "H5Lget_info_by_idx") ;
-      }
-      if (not (linfo.type == H5L_TYPE_SOFT and int(m_type) & int(SoftLink)) and
-          not (linfo.type == H5L_TYPE_HARD and int(m_type) & int(HardLink))) continue;
-    }
-
-    // first try with the fixed buffer size
-    ssize_t size = H5Lget_name_by_idx(m_group.id(), ".", H5_INDEX_NAME, H5_ITER_NATIVE, m_idx, buf, maxsize, H5P_DEFAULT);
-    if (size < 0) {
-      throw Hdf5CallException( ERR_LOC, "H5Lget_name_by_idx") ;
-    }
-    if (size == 0) {
-      // name is not known
-      continue;
-    }
-    if (size <= maxsize) {
-      // name has fit into buffer
-      result = buf;
-    } else {
-      // another try with dynamically allocated buffer
-      char* dbuf = new char[size+1];
-      H5Lget_name_by_idx(m_group.id(), ".", H5_INDEX_NAME, H5_ITER_NATIVE, m_idx, dbuf, size, H5P_DEFAULT);
-      result = dbuf;
-      delete [] dbuf;
+      if (not (entry.linkType == H5L_TYPE_SOFT and int(m_type) & int(SoftLink)) and
+          not (entry.linkType == H5L_TYPE_HARD and int(m_type) & int(HardLink))) continue;
     }
-
+    ++ m_idx;
+    return &entry;
   }
-
-  return result;
+  return 0;
 }
 
 } // namespace hdf5pp
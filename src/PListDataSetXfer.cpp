@@ -0,0 +1,61 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class PListDataSetXfer...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/PListDataSetXfer.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Exceptions.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+//----------------
+// Constructors --
+//----------------
+PListDataSetXfer::PListDataSetXfer ()
+  : m_impl()
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+PListDataSetXfer::~PListDataSetXfer ()
+{
+}
+
+// define memory management functions for variable-length data
+void
+PListDataSetXfer::set_vlen_mem_manager(H5MM_allocate_t alloc_func, void* alloc_info,
+    H5MM_free_t free_func, void* free_info)
+{
+  m_impl.setClass(H5P_DATASET_XFER);
+  herr_t stat = H5Pset_vlen_mem_manager(m_impl.id(), alloc_func, alloc_info, free_func, free_info);
+  if (stat < 0) {
+    throw Hdf5CallException(ERR_LOC, "H5Pset_vlen_mem_manager");
+  }
+}
+
+} // namespace hdf5pp
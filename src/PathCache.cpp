@@ -0,0 +1,189 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class PathCache...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/PathCache.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Catalog.h"
+#include "hdf5pp/Exceptions.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+//----------------
+// Constructors --
+//----------------
+PathCache::PathCache()
+  : m_mutex()
+  , m_entries()
+  , m_missing()
+  , m_catalog()
+  , m_hits(0)
+  , m_misses(0)
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+PathCache::~PathCache()
+{
+}
+
+// Find path in cache.
+PathCache::Status
+PathCache::find(const std::string& path, Entry& entry)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  Entries::const_iterator it = m_entries.find(path);
+  if (it != m_entries.end()) {
+    ++ m_hits;
+    entry = it->second;
+    return Exists;
+  }
+  if (m_missing.count(path)) {
+    ++ m_hits;
+    return Missing;
+  }
+  if (m_catalog) {
+    if (const Catalog::Object* obj = m_catalog->find(path)) {
+      ++ m_hits;
+      entry.type = obj->type;
+      entry.token = obj->token;
+      return Exists;
+    }
+  }
+  ++ m_misses;
+  return Unknown;
+}
+
+// Remember that link exists.
+void
+PathCache::insert(const std::string& path, const Entry& entry)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+
+  m_missing.erase(path);
+  std::pair<Entries::iterator, bool> res = m_entries.insert(std::make_pair(path, entry));
+  if (not res.second and entry.type != H5O_TYPE_UNKNOWN) res.first->second = entry;
+}
+
+// Remember that link does not exist.
+void
+PathCache::insertMissing(const std::string& path)
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_missing.insert(path);
+}
+
+// Use catalog of the file for lookups.
+void
+PathCache::setCatalog(const Catalog& catalog)
+{
+  boost::shared_ptr<const Catalog> ptr(new Catalog(catalog));
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_catalog = ptr;
+}
+
+// Drop all negative entries.
+void
+PathCache::invalidate()
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_missing.clear();
+}
+
+// Remove all entries.
+void
+PathCache::clear()
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_entries.clear();
+  m_missing.clear();
+  m_catalog.reset();
+}
+
+// Get number of entries in cache, positive and negative.
+size_t
+PathCache::size() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_entries.size() + m_missing.size();
+}
+
+// Get number of lookups which found path in cache.
+unsigned long
+PathCache::hits() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_hits;
+}
+
+// Get number of lookups which did not find path in cache.
+unsigned long
+PathCache::misses() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_misses;
+}
+
+// Get type and token of an open object.
+PathCache::Entry
+PathCache::objectInfo(hid_t id)
+{
+  Entry entry;
+#if H5_VERSION_GE(1,12,0)
+  H5O_info2_t info;
+  if (H5Oget_info3(id, &info, H5O_INFO_BASIC) < 0) throw Hdf5CallException(ERR_LOC, "H5Oget_info3");
+  entry.token = info.token;
+#elif H5_VERSION_GE(1,10,3)
+  H5O_info_t info;
+  if (H5Oget_info2(id, &info, H5O_INFO_BASIC) < 0) throw Hdf5CallException(ERR_LOC, "H5Oget_info2");
+  entry.token = info.addr;
+#else
+  H5O_info_t info;
+  if (H5Oget_info(id, &info) < 0) throw Hdf5CallException(ERR_LOC, "H5Oget_info");
+  entry.token = info.addr;
+#endif
+  entry.type = info.type;
+  return entry;
+}
+
+// Open object by its token.
+hid_t
+PathCache::open(hid_t loc, const Entry& entry)
+{
+#if H5_VERSION_GE(1,12,0)
+  hid_t id = H5Oopen_by_token(loc, entry.token);
+  if (id < 0) throw Hdf5CallException(ERR_LOC, "H5Oopen_by_token");
+#else
+  hid_t id = H5Oopen_by_addr(loc, entry.token);
+  if (id < 0) throw Hdf5CallException(ERR_LOC, "H5Oopen_by_addr");
+#endif
+  return id;
+}
+
+} // namespace hdf5pp
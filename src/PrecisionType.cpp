@@ -0,0 +1,157 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class PrecisionType...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/PrecisionType.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <map>
+#include <vector>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include <boost/thread/mutex.hpp>
+#include "hdf5pp/Exceptions.h"
+#include "hdf5pp/TypeCache.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  // types are identified by the kind of type and its parameters
+  enum Kind { Float, TruncatedFloat, Integer };
+  typedef std::vector<size_t> Key;
+  typedef std::map<Key, hdf5pp::Type> TypeMap;
+
+  // cache is never destroyed, types in it must outlive all users
+  TypeMap& cache()
+  {
+    static TypeMap* cache = new TypeMap;
+    return *cache;
+  }
+
+  boost::mutex& cacheMutex()
+  {
+    static boost::mutex* mutex = new boost::mutex;
+    return *mutex;
+  }
+
+  // make float type with given layout, fields have to be set before
+  // offset and precision so that they are always within type precision
+  hdf5pp::Type makeFloat(size_t size, size_t offset, size_t ebits, size_t mbits)
+  {
+    hdf5pp::Type type = hdf5pp::Type::Copy(H5T_IEEE_F64LE);
+    size_t precision = 1 + ebits + mbits;
+    type.set_fields(offset + precision - 1, offset + mbits, ebits, offset, mbits);
+    type.set_offset(offset);
+    type.set_precision(precision);
+    type.set_size(size);
+    type.set_ebias((size_t(1) << (ebits - 1)) - 1);
+    return type;
+  }
+
+  // find type in cache or make new one
+  hdf5pp::Type get(const Key& key)
+  {
+    boost::mutex::scoped_lock lock(cacheMutex());
+    TypeMap& c = cache();
+    TypeMap::const_iterator it = c.find(key);
+    if (it != c.end()) return it->second;
+
+    hdf5pp::Type type;
+    switch (key[0]) {
+    case Float:
+      type = makeFloat((1 + key[1] + key[2] + 7) / 8, 0, key[1], key[2]);
+      break;
+    case TruncatedFloat:
+      type = makeFloat(4, 23 - key[1], 8, key[1]);
+      break;
+    case Integer:
+      {
+        // key is (kind, size, sign, order, precision, offset)
+        type = hdf5pp::Type::Copy(key[2] == H5T_SGN_NONE ? H5T_STD_U8LE : H5T_STD_I8LE);
+        type.set_size(key[1]);
+        if (H5Tset_order(type.id(), H5T_order_t(key[3])) < 0) {
+          throw hdf5pp::Hdf5CallException(ERR_LOC, "H5Tset_order");
+        }
+        type.set_precision(key[4]);
+        type.set_offset(key[5]);
+      }
+      break;
+    }
+
+    type = hdf5pp::TypeCache::lockedCopy(type);
+    c.insert(std::make_pair(key, type));
+    return type;
+  }
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Floating point type with given exponent and mantissa sizes.
+Type
+PrecisionType::floatType(unsigned ebits, unsigned mbits)
+{
+  if (ebits < 2 or ebits > 11 or mbits < 1 or mbits > 52) {
+    throw Exception(ERR_LOC, "PrecisionType", "unsupported exponent or mantissa size");
+  }
+  Key key(3);
+  key[0] = Float;
+  key[1] = ebits;
+  key[2] = mbits;
+  return ::get(key);
+}
+
+// Single-precision float type with mantissa truncated to given number of bits.
+Type
+PrecisionType::truncatedFloat(unsigned mbits)
+{
+  if (mbits < 1 or mbits > 23) {
+    throw Exception(ERR_LOC, "PrecisionType", "unsupported mantissa size");
+  }
+  Key key(2);
+  key[0] = TruncatedFloat;
+  key[1] = mbits;
+  return ::get(key);
+}
+
+// Integer type with reduced precision.
+Type
+PrecisionType::integerType(const Type& baseType, unsigned precision, unsigned offset)
+{
+  if (baseType.tclass() != H5T_INTEGER) {
+    throw Exception(ERR_LOC, "PrecisionType", "base type is not integer type");
+  }
+  size_t size = baseType.size();
+  if (precision < 1 or offset + precision > size*8) {
+    throw Exception(ERR_LOC, "PrecisionType", "precision and offset do not fit into integer type");
+  }
+  Key key(6);
+  key[0] = Integer;
+  key[1] = size;
+  key[2] = H5Tget_sign(baseType.id());
+  key[3] = H5Tget_order(baseType.id());
+  key[4] = precision;
+  key[5] = offset;
+  return ::get(key);
+}
+
+} // namespace hdf5pp
@@ -0,0 +1,292 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class RowAppender...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/RowAppender.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <cstring>
+#include <vector>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/DataSpace.h"
+#include "hdf5pp/Exceptions.h"
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.RowAppender";
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Implementation is shared between all copies of the appender,
+// destructor writes whatever is left in the buffer.
+struct RowAppender::Impl {
+
+  // one column, records are buffered per column so that each buffer
+  // is a contiguous block for a single dataset
+  struct Column {
+    DataSet ds;               ///< Dataset to write to
+    Type type;                ///< In-memory type of records
+    size_t recSize;           ///< Size of one record in memory
+    std::vector<char> buffer; ///< Records buffer
+  };
+
+  Impl(hsize_t bufSize);
+  ~Impl();
+
+  unsigned add(const DataSet& ds, const Type& native_type);
+  void append(const void* const row[]);
+  void flush();
+
+  // write buffered data for all columns
+  void write(const DataSpace& memDsp, std::vector<DataSpace>& fileDsps);
+
+  std::vector<Column> m_columns; ///< Columns
+  hsize_t m_bufSize;             ///< Buffer size in rows
+  hsize_t m_size;                ///< Datasets size, not including buffered rows
+  hsize_t m_count;               ///< Number of buffered rows
+  hsize_t m_limit;               ///< Number of rows after which buffer is flushed
+};
+
+RowAppender::Impl::Impl(hsize_t bufSize)
+  : m_columns()
+  , m_bufSize(bufSize)
+  , m_size(0)
+  , m_count(0)
+  , m_limit(0)
+{
+}
+
+RowAppender::Impl::~Impl()
+{
+  // cannot let exceptions escape from destructor
+  try {
+    flush();
+  } catch (const std::exception& ex) {
+    MsgLog(logger, error, "RowAppender: failed to flush buffered data: " << ex.what());
+  }
+}
+
+unsigned
+RowAppender::Impl::add(const DataSet& ds, const Type& native_type)
+{
+  if (m_limit != 0) {
+    throw Exception(ERR_LOC, "RowAppender", "cannot add column after rows were appended");
+  }
+
+  DataSet dset = ds;
+  unsigned rank = dset.dataSpace().rank();
+  if (rank != 1) throw Hdf5RankMismatch(ERR_LOC, 1, rank);
+
+  hsize_t size = dset.size();
+  if (m_columns.empty()) {
+    m_size = size;
+  } else if (size != m_size) {
+    throw Exception(ERR_LOC, "RowAppender", "dataset " + dset.name() + " has different size from other columns");
+  }
+
+  Column col;
+  col.ds = dset;
+  col.type = native_type;
+  col.recSize = native_type.size();
+  m_columns.push_back(col);
+
+  MsgLog(logger, debug, "RowAppender: column=" << m_columns.size()-1 << " dataset=" << dset.name()
+         << " size=" << size);
+
+  return m_columns.size()-1;
+}
+
+void
+RowAppender::Impl::append(const void* const row[])
+{
+  if (m_columns.empty()) throw Exception(ERR_LOC, "RowAppender", "no columns defined");
+
+  if (m_limit == 0) {
+    // first row, columns cannot change any more, allocate buffers
+    if (m_bufSize == 0) {
+      for (std::vector<Column>::const_iterator it = m_columns.begin(); it != m_columns.end(); ++ it) {
+        hsize_t chunk = it->ds.chunkSize();
+        if (m_bufSize == 0 or chunk < m_bufSize) m_bufSize = chunk;
+      }
+    }
+    for (std::vector<Column>::iterator it = m_columns.begin(); it != m_columns.end(); ++ it) {
+      it->buffer.resize(m_bufSize * it->recSize);
+    }
+    // first batch only fills the rest of the current chunk
+    m_limit = m_bufSize - m_size % m_bufSize;
+  }
+
+  for (unsigned i = 0; i != m_columns.size(); ++ i) {
+    Column& col = m_columns[i];
+    std::memcpy(&col.buffer[m_count * col.recSize], row[i], col.recSize);
+  }
+  if (++ m_count == m_limit) flush();
+}
+
+void
+RowAppender::Impl::flush()
+{
+  if (m_count == 0) return;
+
+  hsize_t newSize = m_size + m_count;
+  try {
+
+    // extend all datasets first
+    for (std::vector<Column>::iterator it = m_columns.begin(); it != m_columns.end(); ++ it) {
+      it->ds.resize(newSize);
+    }
+
+    // same selection in every dataset
+    hsize_t start[] = { m_size };
+    hsize_t count[] = { m_count };
+    std::vector<DataSpace> fileDsps;
+    fileDsps.reserve(m_columns.size());
+    for (std::vector<Column>::iterator it = m_columns.begin(); it != m_columns.end(); ++ it) {
+      fileDsps.push_back(it->ds.dataSpace());
+      fileDsps.back().select_hyperslab(H5S_SELECT_SET, start, 0, count, 0);
+    }
+    DataSpace memDsp = DataSpace::makeSimple(m_count, m_count);
+
+    write(memDsp, fileDsps);
+
+  } catch (...) {
+    // shrink all columns back to the last written row so that they stay
+    // the same size, buffered rows are kept
+    for (std::vector<Column>::iterator it = m_columns.begin(); it != m_columns.end(); ++ it) {
+      try {
+        if (it->ds.size() != m_size) it->ds.resize(m_size);
+      } catch (const std::exception& ex) {
+        MsgLog(logger, error, "RowAppender: failed to restore size of dataset " << it->ds.name() << ": " << ex.what());
+      }
+    }
+    throw;
+  }
+
+  m_size = newSize;
+  m_count = 0;
+  m_limit = m_bufSize;
+}
+
+void
+RowAppender::Impl::write(const DataSpace& memDsp, std::vector<DataSpace>& fileDsps)
+{
+#if H5_VERSION_GE(1,14,0)
+
+  // single call for all datasets, conversions are checked (and counted)
+  // for each dataset the same way as in DataSet::store()
+  size_t ncol = m_columns.size();
+  std::vector<hid_t> dsIds(ncol), typeIds(ncol), memIds(ncol, memDsp.id()), fileIds(ncol);
+  std::vector<const void*> bufs(ncol);
+  for (size_t i = 0; i != ncol; ++ i) {
+    m_columns[i].ds._checkConversion(m_columns[i].type, memDsp, fileDsps[i]);
+    dsIds[i] = m_columns[i].ds.id();
+    typeIds[i] = m_columns[i].type.id();
+    fileIds[i] = fileDsps[i].id();
+    bufs[i] = &m_columns[i].buffer.front();
+  }
+  herr_t stat = H5Dwrite_multi(ncol, &dsIds.front(), &typeIds.front(), &memIds.front(),
+                               &fileIds.front(), H5P_DEFAULT, &bufs.front());
+  if (stat < 0) {
+    MsgLog(logger, error, "H5Dwrite_multi failed, first dataset name: " << m_columns.front().ds.name());
+    throw Hdf5CallException(ERR_LOC, "H5Dwrite_multi");
+  }
+
+#else
+
+  for (size_t i = 0; i != m_columns.size(); ++ i) {
+    Column& col = m_columns[i];
+    col.ds.store(memDsp, fileDsps[i], static_cast<const void*>(&col.buffer.front()), col.type);
+  }
+
+#endif
+}
+
+//----------------
+// Constructors --
+//----------------
+RowAppender::RowAppender(hsize_t bufSize)
+  : m_impl(new Impl(bufSize))
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+RowAppender::~RowAppender()
+{
+}
+
+// Add one column.
+unsigned
+RowAppender::add(const DataSet& ds, const Type& native_type)
+{
+  return m_impl->add(ds, native_type);
+}
+
+// Add one row.
+void
+RowAppender::append(const void* const row[])
+{
+  m_impl->append(row);
+}
+
+// Write all buffered rows to datasets.
+void
+RowAppender::flush()
+{
+  m_impl->flush();
+}
+
+// Get number of columns
+unsigned
+RowAppender::columns() const
+{
+  return m_impl->m_columns.size();
+}
+
+// Get number of rows including rows which are still in buffer
+hsize_t
+RowAppender::size() const
+{
+  return m_impl->m_size + m_impl->m_count;
+}
+
+// Get number of rows in buffer which have not been written yet
+hsize_t
+RowAppender::buffered() const
+{
+  return m_impl->m_count;
+}
+
+// Get dataset object for given column
+DataSet
+RowAppender::dataSet(unsigned column) const
+{
+  return m_impl->m_columns.at(column).ds;
+}
+
+} // namespace hdf5pp
@@ -0,0 +1,82 @@
+#ifndef HDF5PP_SNAPSHOT_H
+#define HDF5PP_SNAPSHOT_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class Snapshot.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Copy-on-write container for data which is read often and updated rarely.
+ *
+ *  This is an implementation detail of the package. Readers get current
+ *  immutable version of the data without locking. Writers lock mutex(),
+ *  make updated copy of the current version and publish() it. Old versions
+ *  are never deleted because readers may still use them, so this is only
+ *  suitable for data which stops changing after initial warm-up, and
+ *  Snapshot objects themselves should never be destroyed.
+ *
+ *  @version $Id$
+ */
+
+template <typename T>
+class Snapshot : boost::noncopyable {
+public:
+
+  Snapshot() : m_current(0) { publish(new T); }
+
+  /// Get current version, lock-free
+  const T& get() const { return *m_current.load(boost::memory_order_acquire); }
+
+  /// Mutex which has to be locked by writers
+  boost::mutex& mutex() { return m_mutex; }
+
+  /// Make new version current, takes ownership, must be called with mutex() locked
+  void publish(T* data) {
+    m_versions.push_back(data);
+    m_current.store(data, boost::memory_order_release);
+  }
+
+private:
+
+  boost::atomic<const T*> m_current;
+  std::vector<const T*> m_versions;
+  boost::mutex m_mutex;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_SNAPSHOT_H
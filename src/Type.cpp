@@ -129,6 +129,33 @@ Type::set_precision( size_t precision )
   }
 }
 
+/// set bit offset of the first significant bit
+void
+Type::set_offset( size_t offset )
+{
+  if ( H5Tset_offset( *m_id, offset ) ) {
+    throw Hdf5CallException( ERR_LOC, "H5Tset_offset" ) ;
+  }
+}
+
+/// set floating point bit field positions and sizes
+void
+Type::set_fields( size_t spos, size_t epos, size_t esize, size_t mpos, size_t msize )
+{
+  if ( H5Tset_fields( *m_id, spos, epos, esize, mpos, msize ) ) {
+    throw Hdf5CallException( ERR_LOC, "H5Tset_fields" ) ;
+  }
+}
+
+/// set floating point exponent bias
+void
+Type::set_ebias( size_t ebias )
+{
+  if ( H5Tset_ebias( *m_id, ebias ) ) {
+    throw Hdf5CallException( ERR_LOC, "H5Tset_ebias" ) ;
+  }
+}
+
 // Insertion operator dumps type information in HDF5 DDL format.
 std::ostream&
 operator<<(std::ostream& out, const Type& dtype)
@@ -0,0 +1,200 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class TypeCache...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/TypeCache.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <map>
+#include <string>
+#include <vector>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include <boost/thread/mutex.hpp>
+#include "hdf5pp/Exceptions.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  // one cached derived type
+  template <typename DerivedType>
+  struct Entry {
+    Entry(const hdf5pp::Type& base, const DerivedType& type) : base(base), type(type) {}
+    hdf5pp::Type base;          ///< Base type, copy is kept so that its ID is not reused
+    DerivedType type;           ///< Derived type
+  };
+
+  // array types are grouped by rank and dimensions, only types in the
+  // same group need to be compared
+  typedef std::vector<hsize_t> ArrayKey;
+  typedef std::vector<Entry<hdf5pp::ArrayType> > ArrayEntries;
+  typedef std::map<ArrayKey, ArrayEntries> ArrayMap;
+
+  typedef std::map<size_t, hdf5pp::Type> StringMap;
+
+  // subset types are grouped by the list of member names
+  typedef std::vector<std::string> SubsetKey;
+  typedef std::vector<Entry<hdf5pp::Type> > SubsetEntries;
+  typedef std::map<SubsetKey, SubsetEntries> SubsetMap;
+
+  // all maps are protected by one mutex, lookups are short compared to
+  // anything done with the types
+  struct Cache {
+    ArrayMap arrays;
+    StringMap strings;
+    SubsetMap subsets;
+    boost::mutex mutex;
+  };
+
+  // cache is never destroyed, types in it must outlive all users
+  Cache& cache()
+  {
+    static Cache* cache = new Cache;
+    return *cache;
+  }
+
+  // find derived type for a base type, first by ID then structurally
+  template <typename Map>
+  const typename Map::mapped_type::value_type*
+  find(const Map& map, const typename Map::key_type& key, const hdf5pp::Type& base)
+  {
+    typename Map::const_iterator mit = map.find(key);
+    if (mit == map.end()) return 0;
+
+    typedef typename Map::mapped_type Entries;
+    const Entries& entries = mit->second;
+    hid_t baseId = base.id();
+    for (typename Entries::const_iterator it = entries.begin(); it != entries.end(); ++ it) {
+      if (it->base.id() == baseId) return &*it;
+    }
+    for (typename Entries::const_iterator it = entries.begin(); it != entries.end(); ++ it) {
+      htri_t eq = H5Tequal(it->base.id(), baseId);
+      if (eq < 0) throw hdf5pp::Hdf5CallException(ERR_LOC, "H5Tequal");
+      if (eq > 0) return &*it;
+    }
+    return 0;
+  }
+
+  // lock type and wrap it into non-owning object
+  hdf5pp::Type lock(hid_t tid, const char* func)
+  {
+    if (tid < 0) throw hdf5pp::Hdf5CallException(ERR_LOC, func);
+    if (H5Tlock(tid) < 0) {
+      H5Tclose(tid);
+      throw hdf5pp::Hdf5CallException(ERR_LOC, "H5Tlock");
+    }
+    return hdf5pp::Type::LockedType(tid);
+  }
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Get array type.
+ArrayType
+TypeCache::arrayType(const Type& baseType, unsigned rank, const hsize_t dims[])
+{
+  ArrayKey key(dims, dims+rank);
+  key.push_back(rank);
+
+  Cache& c = cache();
+  boost::mutex::scoped_lock lock(c.mutex);
+  if (const Entry<ArrayType>* entry = ::find(c.arrays, key, baseType)) return entry->type;
+
+  ArrayType array(::lock(H5Tarray_create2(baseType.id(), rank, dims), "H5Tarray_create2"));
+  c.arrays[key].push_back(Entry<ArrayType>(baseType, array));
+  return array;
+}
+
+// Get fixed-size string type.
+Type
+TypeCache::stringType(size_t size)
+{
+  Cache& c = cache();
+  boost::mutex::scoped_lock lock(c.mutex);
+  StringMap::const_iterator it = c.strings.find(size);
+  if (it != c.strings.end()) return it->second;
+
+  hid_t tid = H5Tcopy(H5T_C_S1);
+  if (tid < 0) throw Hdf5CallException(ERR_LOC, "H5Tcopy");
+  if (H5Tset_size(tid, size) < 0) {
+    H5Tclose(tid);
+    throw Hdf5CallException(ERR_LOC, "H5Tset_size");
+  }
+  Type type = ::lock(tid, "H5Tcopy");
+  c.strings.insert(std::make_pair(size, type));
+  return type;
+}
+
+// Get subset of compound type.
+Type
+TypeCache::subsetType(const Type& compoundType, const std::vector<std::string>& members)
+{
+  Cache& c = cache();
+  boost::mutex::scoped_lock lock(c.mutex);
+  if (const Entry<Type>* entry = ::find(c.subsets, members, compoundType)) return entry->type;
+
+  if (compoundType.tclass() != H5T_COMPOUND) {
+    throw Exception(ERR_LOC, "TypeCache", "subset type can only be made for compound types");
+  }
+
+  // new type of the same size with the same member offsets
+  hid_t baseId = compoundType.id();
+  hid_t tid = H5Tcreate(H5T_COMPOUND, compoundType.size());
+  if (tid < 0) throw Hdf5CallException(ERR_LOC, "H5Tcreate");
+  Type tmp = Type::UnlockedType(tid);
+  for (std::vector<std::string>::const_iterator it = members.begin(); it != members.end(); ++ it) {
+    int idx = H5Tget_member_index(baseId, it->c_str());
+    if (idx < 0) throw Exception(ERR_LOC, "TypeCache", "compound type has no member named " + *it);
+    size_t offset = H5Tget_member_offset(baseId, idx);
+    hid_t mtype = H5Tget_member_type(baseId, idx);
+    if (mtype < 0) throw Hdf5CallException(ERR_LOC, "H5Tget_member_type");
+    herr_t stat = H5Tinsert(tid, it->c_str(), offset, mtype);
+    H5Tclose(mtype);
+    if (stat < 0) throw Hdf5CallException(ERR_LOC, "H5Tinsert");
+  }
+
+  Type subset = ::lock(H5Tcopy(tid), "H5Tcopy");
+  c.subsets[members].push_back(Entry<Type>(compoundType, subset));
+  return subset;
+}
+
+// Make locked copy of a type.
+Type
+TypeCache::lockedCopy(const Type& type)
+{
+  return ::lock(H5Tcopy(type.id()), "H5Tcopy");
+}
+
+// Get number of types in cache.
+size_t
+TypeCache::size()
+{
+  Cache& c = cache();
+  boost::mutex::scoped_lock lock(c.mutex);
+  size_t size = c.strings.size();
+  for (ArrayMap::const_iterator it = c.arrays.begin(); it != c.arrays.end(); ++ it) size += it->second.size();
+  for (SubsetMap::const_iterator it = c.subsets.begin(); it != c.subsets.end(); ++ it) size += it->second.size();
+  return size;
+}
+
+} // namespace hdf5pp
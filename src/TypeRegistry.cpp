@@ -0,0 +1,109 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class TypeRegistry...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/TypeRegistry.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <map>
+#include <boost/thread/recursive_mutex.hpp>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/TypeCache.h"
+#include "hdf5pp/TypeTraits.h"
+#include "Snapshot.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  typedef std::map<hdf5pp::TypeRegistry::Factory, hdf5pp::Type> Registry;
+
+  // registry is never destroyed, types in it must outlive all users
+  hdf5pp::Snapshot<Registry>& registry()
+  {
+    static hdf5pp::Snapshot<Registry>* registry = new hdf5pp::Snapshot<Registry>;
+    return *registry;
+  }
+
+  // serializes factory calls, recursive because factory may call get()
+  // for member types
+  boost::recursive_mutex& factoryMutex()
+  {
+    static boost::recursive_mutex* mutex = new boost::recursive_mutex;
+    return *mutex;
+  }
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+// Get type built by a factory function.
+Type
+TypeRegistry::get(Factory factory)
+{
+  // lock-free lookup in current version
+  Snapshot<Registry>& r = registry();
+  Registry::const_iterator it = r.get().find(factory);
+  if (it != r.get().end()) return it->second;
+
+  // only one thread creates types at a time, HDF5 may not be thread-safe
+  boost::recursive_mutex::scoped_lock factoryLock(factoryMutex());
+
+  // could have been added by other thread
+  it = r.get().find(factory);
+  if (it != r.get().end()) return it->second;
+
+  Type type = TypeCache::lockedCopy(factory());
+
+  boost::mutex::scoped_lock lock(r.mutex());
+  Registry* update = new Registry(r.get());
+  update->insert(std::make_pair(factory, type));
+  r.publish(update);
+  return type;
+}
+
+// Create types for all built-in TypeTraits.
+void
+TypeRegistry::warmup()
+{
+  TypeTraits<float>::native_type();
+  TypeTraits<double>::native_type();
+  TypeTraits<long double>::native_type();
+  TypeTraits<int8_t>::native_type();
+  TypeTraits<uint8_t>::native_type();
+  TypeTraits<int16_t>::native_type();
+  TypeTraits<uint16_t>::native_type();
+  TypeTraits<int32_t>::native_type();
+  TypeTraits<uint32_t>::native_type();
+  TypeTraits<int64_t>::native_type();
+  TypeTraits<uint64_t>::native_type();
+  TypeTraits<const char*>::native_type();
+}
+
+// Get number of registered user types
+size_t
+TypeRegistry::size()
+{
+  return registry().get().size();
+}
+
+} // namespace hdf5pp
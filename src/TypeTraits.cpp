@@ -22,12 +22,25 @@
 //-------------------------------
 // Collaborating Class Headers --
 //-------------------------------
-#include "hdf5pp/ArrayType.h"
+#include "hdf5pp/TypeCache.h"
 
 //-----------------------------------------------------------------------
 // Local Macros, Typedefs, Structures, Unions and Forward Declarations --
 //-----------------------------------------------------------------------
 
+namespace {
+
+  // make locked variable-size string type
+  hdf5pp::Type varStringType()
+  {
+    hid_t tid = H5Tcopy ( H5T_C_S1 ) ;
+    H5Tset_size( tid, H5T_VARIABLE ) ;
+    H5Tlock ( tid ) ;
+    return hdf5pp::Type::LockedType(tid) ;
+  }
+
+}
+
 //		----------------------------------------
 // 		-- Public Function Member Definitions --
 //		----------------------------------------
@@ -37,22 +50,13 @@ namespace hdf5pp {
 Type
 TypeTraitsHelper::string_h5type (size_t size)
 {
-  static hid_t string_h5type_inst ;
   if (size == 0) {
     // return variable-size string type
-    static bool initialized = false ;
-    if ( not initialized ) {
-      initialized = true ;
-      string_h5type_inst = H5Tcopy ( H5T_C_S1 ) ;
-      H5Tset_size( string_h5type_inst, H5T_VARIABLE ) ;
-      H5Tlock ( string_h5type_inst ) ;
-    }
-    return Type::LockedType(string_h5type_inst) ;
+    static const Type string_h5type_inst = ::varStringType();
+    return string_h5type_inst ;
   } else {
     // return fixed-size string type
-    hid_t type = H5Tcopy ( H5T_C_S1 ) ;
-    H5Tset_size(type, size);
-    return Type::UnlockedType(type);
+    return TypeCache::stringType(size);
   }
 }
 
@@ -60,7 +64,7 @@ Type
 TypeTraitsHelper::sized_h5type(const Type& type, size_t size)
 {
   if (size == 0) return type;
-  return ArrayType::arrayType(type, size);
+  return TypeCache::arrayType(type, size);
 }
 
 } // namespace hdf5pp
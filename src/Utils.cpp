@@ -21,10 +21,12 @@
 //-----------------
 #include <iostream>
 #include <algorithm>
+#include <numeric>
 
 //-------------------------------
 // Collaborating Class Headers --
 //-------------------------------
+#include "hdf5pp/CompoundType.h"
 
 //-----------------------------------------------------------------------
 // Local Macros, Typedefs, Structures, Unions and Forward Declarations --
@@ -72,12 +74,11 @@ Utils::resizeDataset(hdf5pp::Group group, const std::string& dataset, long size)
 
   if (size < 0) {
     // get current size and increase by one
-    DataSpace dsp = ds.dataSpace();
-    size = dsp.size() + 1;
+    size = ds.size() + 1;
   }
 
-  // change extent to new value
-  ds.set_extent(size);
+  // change size to new value
+  ds.resize(size);
 }
 
 // template-free implementation of append()
@@ -89,17 +90,16 @@ Utils::_storeAt(hdf5pp::Group group, const std::string& dataset, const void* dat
   DataSet ds = group.openDataSet(dataset);
 
   // get current size
-  DataSpace dsp = ds.dataSpace();
-  hsize_t size = dsp.size();
+  hsize_t size = ds.size();
 
   // extend dataset if needed
   if (index < 0) index = size;
   if (index >= long(size)) {
-    ds.set_extent(index+1);
+    ds.resize(index+1);
   }
 
   // get updated dataspace
-  dsp = ds.dataSpace();
+  DataSpace dsp = ds.dataSpace();
 
   // store the data in dataset
   ds.store(DataSpace::makeScalar(), dsp.select_single(index), data, native_type);
@@ -120,7 +120,8 @@ Utils::_storeScalar(hdf5pp::Group group, const std::string& dataset, const void*
 // template-free implementation of storeArray()
 void
 Utils::_storeArray(hdf5pp::Group group, const std::string& dataset, const void* data,
-    unsigned rank, const unsigned* shape, const Type& native_type, const Type& stored_type)
+    unsigned rank, const unsigned* shape, const Type& native_type, const Type& stored_type,
+    const PListDataSetCreate& plistDScreate)
 {
   hsize_t size = std::accumulate(shape, shape+rank, hsize_t(1), std::multiplies<hsize_t>());
   if (size > 0) {
@@ -137,7 +138,7 @@ Utils::_storeArray(hdf5pp::Group group, const std::string& dataset, const void*
     }
 
     // create new dataspace
-    DataSet ds = group.createDataSet(dataset, stored_type, dsp);
+    DataSet ds = group.createDataSet(dataset, stored_type, dsp, plistDScreate);
 
     // store the data in dataset
     ds.store(dsp, dsp, data, native_type);
@@ -151,6 +152,113 @@ Utils::_storeArray(hdf5pp::Group group, const std::string& dataset, const void*
   }
 }
 
+// Read members of compound rank-1 dataset into separate arrays.
+hsize_t
+Utils::readColumns(hdf5pp::DataSet ds, Columns& columns, hsize_t start, hsize_t count)
+{
+  DataSpace fileDsp = ds.dataSpace();
+  if (fileDsp.rank() != 1) throw Hdf5RankMismatch(ERR_LOC, 1, fileDsp.rank());
+  hsize_t size = ds.size();
+  if (start > size) start = size;
+  count = std::min(count, size - start);
+
+  Type fileType = ds.type();
+  if (fileType.tclass() != H5T_COMPOUND) {
+    throw Exception(ERR_LOC, "Utils", "readColumns: dataset type is not compound: " + ds.name());
+  }
+
+  // memory type for each column is a compound with single member at offset 0
+  std::vector<Type> memTypes;
+  std::vector<char*> data;
+  std::vector<size_t> elemSizes;
+  for (size_t i = 0; i != columns.size(); ++ i) {
+    const std::string& member = columns.member(i);
+    const Type& type = columns.type(i);
+    if (H5Tget_member_index(fileType.id(), member.c_str()) < 0) {
+      throw Exception(ERR_LOC, "Utils", "readColumns: dataset " + ds.name() + " has no member " + member);
+    }
+    htri_t vlen = H5Tdetect_class(type.id(), H5T_VLEN);
+    if ( vlen < 0 ) throw Hdf5CallException( ERR_LOC, "H5Tdetect_class" ) ;
+    if (vlen > 0 or (type.tclass() == H5T_STRING and H5Tis_variable_str(type.id()) > 0)) {
+      throw Exception(ERR_LOC, "Utils", "readColumns: variable-length column types are not supported: " + member);
+    }
+    CompoundType memType = CompoundType::compoundType(type.size());
+    memType.insert(member.c_str(), 0, type);
+    memTypes.push_back(memType);
+    data.push_back(static_cast<char*>(columns.allocate(i, count)));
+    elemSizes.push_back(type.size());
+  }
+
+  // read one chunk at a time, whole range at once for non-chunked datasets
+  hsize_t step = 0;
+  hid_t plist = H5Dget_create_plist(ds.id());
+  if (plist < 0) throw Hdf5CallException( ERR_LOC, "H5Dget_create_plist" ) ;
+  H5D_layout_t layout = H5Pget_layout(plist);
+  H5Pclose(plist);
+  if (layout == H5D_CHUNKED) step = ds.chunkSize();
+
+  for (hsize_t pos = start; pos < start + count; ) {
+    hsize_t next = start + count;
+    if (step > 0) next = std::min(next, (pos / step + 1) * step);
+    hsize_t n = next - pos;
+    hsize_t offset[] = { pos };
+    hsize_t dims[] = { n };
+    fileDsp.select_hyperslab(H5S_SELECT_SET, offset, 0, dims, 0);
+    DataSpace memDsp = DataSpace::makeSimple(n, n);
+    for (size_t i = 0; i != memTypes.size(); ++ i) {
+      ds.read(memDsp, fileDsp, data[i] + (pos - start) * elemSizes[i], memTypes[i]);
+    }
+    pos = next;
+  }
+
+  return count;
+}
+
+// template-free implementation of readRagged()
+void
+Utils::_readRagged(hdf5pp::DataSet ds, hsize_t begin, hsize_t end, const Type& native_type,
+    VlenArena& arena, std::vector<hvl_t>& rows)
+{
+  DataSpace fileDsp = ds.dataSpace();
+  if (fileDsp.rank() != 1) throw Hdf5RankMismatch(ERR_LOC, 1, fileDsp.rank());
+  if (ds.type().tclass() != H5T_VLEN) {
+    throw Exception(ERR_LOC, "Utils", "readRagged: dataset type is not VLEN: " + ds.name());
+  }
+
+  hsize_t size = ds.size();
+  end = std::min(end, size);
+  begin = std::min(begin, end);
+  hsize_t count = end - begin;
+  rows.resize(count);
+  if (count == 0) return;
+
+  hsize_t offset[] = { begin };
+  hsize_t dims[] = { count };
+  fileDsp.select_hyperslab(H5S_SELECT_SET, offset, 0, dims, 0);
+  DataSpace memDsp = DataSpace::makeSimple(count, count);
+  ds.read(memDsp, fileDsp, &rows.front(), VlenType::vlenType(native_type), arena.xferPlist());
+}
+
+// template-free implementation of storeRagged()
+void
+Utils::_storeRagged(hdf5pp::DataSet ds, const std::vector<hvl_t>& rows, long begin,
+    const Type& native_type)
+{
+  hsize_t size = ds.size();
+  if (begin < 0) begin = size;
+  hsize_t count = rows.size();
+  if (count == 0) return;
+
+  if (begin + count > size) ds.resize(begin + count);
+
+  DataSpace fileDsp = ds.dataSpace();
+  hsize_t offset[] = { hsize_t(begin) };
+  hsize_t dims[] = { count };
+  fileDsp.select_hyperslab(H5S_SELECT_SET, offset, 0, dims, 0);
+  DataSpace memDsp = DataSpace::makeSimple(count, count);
+  ds.store(memDsp, fileDsp, static_cast<const void*>(&rows.front()), VlenType::vlenType(native_type));
+}
+
 std::vector<std::string> Utils::readListStrings(hdf5pp::Group group, 
                                                 const std::string &dataset, 
                                                 hsize_t index)
@@ -0,0 +1,187 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class VlenArena...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "hdf5pp/VlenArena.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+#include "hdf5pp/Exceptions.h"
+#include "MsgLogger/MsgLogger.h"
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+namespace {
+
+  const char logger[] = "hdf5pp.VlenArena";
+
+  // alignment of all allocations
+  const size_t alignment = 16;
+
+  // set of memory blocks released together
+  class Region {
+  public:
+
+    Region(size_t blockSize) : m_blockSize(blockSize), m_ptr(0), m_left(0), m_size(0) {}
+
+    ~Region() {
+      for (std::vector<char*>::const_iterator it = m_blocks.begin(); it != m_blocks.end(); ++ it) {
+        std::free(*it);
+      }
+    }
+
+    void* allocate(size_t size) {
+      size = (size + alignment - 1) / alignment * alignment;
+      if (size > m_blockSize / 4) {
+        // large allocations get separate block, current block continues
+        char* block = newBlock(size);
+        m_size += size;
+        return block;
+      }
+      if (size > m_left) {
+        m_ptr = newBlock(m_blockSize);
+        m_left = m_blockSize;
+      }
+      void* ptr = m_ptr;
+      m_ptr += size;
+      m_left -= size;
+      m_size += size;
+      return ptr;
+    }
+
+    size_t size() const { return m_size; }
+
+  private:
+
+    char* newBlock(size_t size) {
+      char* block = static_cast<char*>(std::malloc(size));
+      if (not block) throw std::bad_alloc();
+      m_blocks.push_back(block);
+      return block;
+    }
+
+    size_t m_blockSize;
+    std::vector<char*> m_blocks;
+    char* m_ptr;
+    size_t m_left;
+    size_t m_size;
+  };
+
+}
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+struct VlenArena::Impl {
+
+  Impl(size_t blockSize, size_t regionLimit)
+    : blockSize(blockSize), regionLimit(regionLimit), region(new Region(blockSize)), regions(1)
+  {
+    plist.set_vlen_mem_manager(&Impl::h5alloc, this, &Impl::h5free, this);
+  }
+
+  // HDF5 memory management callbacks, exceptions must not escape into HDF5
+  static void* h5alloc(size_t size, void* info) {
+    try {
+      return static_cast<Impl*>(info)->region->allocate(size);
+    } catch (const std::exception& ex) {
+      MsgLog(logger, error, "VlenArena: allocation failed: " << ex.what());
+      return 0;
+    }
+  }
+  static void h5free(void*, void*) {}
+
+  size_t blockSize;                   ///< Block size
+  size_t regionLimit;                 ///< Size limit for maybeNewRegion()
+  boost::shared_ptr<Region> region;   ///< Current region
+  unsigned long regions;              ///< Number of regions made
+  PListDataSetXfer plist;             ///< Transfer property list
+};
+
+//----------------
+// Constructors --
+//----------------
+VlenArena::VlenArena(size_t blockSize, size_t regionLimit)
+  : m_impl(new Impl(blockSize, regionLimit))
+{
+}
+
+//--------------
+// Destructor --
+//--------------
+VlenArena::~VlenArena()
+{
+}
+
+// Get transfer property list
+const PListDataSetXfer&
+VlenArena::xferPlist() const
+{
+  return m_impl->plist;
+}
+
+// Allocate memory from current region
+void*
+VlenArena::allocate(size_t size)
+{
+  return m_impl->region->allocate(size);
+}
+
+// Start new region
+void
+VlenArena::newRegion()
+{
+  m_impl->region.reset(new Region(m_impl->blockSize));
+  ++ m_impl->regions;
+}
+
+// Start new region if current region size is above the limit.
+void
+VlenArena::maybeNewRegion()
+{
+  if (m_impl->region->size() > m_impl->regionLimit) newRegion();
+}
+
+// Get number of bytes allocated in current region.
+size_t
+VlenArena::regionSize() const
+{
+  return m_impl->region->size();
+}
+
+// Get number of regions made so far.
+unsigned long
+VlenArena::regions() const
+{
+  return m_impl->regions;
+}
+
+// shared pointer to current region
+boost::shared_ptr<void>
+VlenArena::_region() const
+{
+  return m_impl->region;
+}
+
+} // namespace hdf5pp
@@ -0,0 +1,96 @@
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class WorkerPool...
+//
+//------------------------------------------------------------------------
+
+//-----------------------
+// This Class's Header --
+//-----------------------
+#include "WorkerPool.h"
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <boost/bind.hpp>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+
+//-----------------------------------------------------------------------
+// Local Macros, Typedefs, Structures, Unions and Forward Declarations --
+//-----------------------------------------------------------------------
+
+//		----------------------------------------
+// 		-- Public Function Member Definitions --
+//		----------------------------------------
+
+namespace hdf5pp {
+
+//----------------
+// Constructors --
+//----------------
+WorkerPool::WorkerPool(unsigned nThreads)
+  : m_nThreads(nThreads)
+  , m_stop(false)
+  , m_tasks()
+  , m_mutex()
+  , m_cond()
+  , m_threads()
+{
+  if (m_nThreads == 0) m_nThreads = boost::thread::hardware_concurrency();
+  if (m_nThreads == 0) m_nThreads = 1;
+  for (unsigned i = 0; i != m_nThreads; ++ i) {
+    m_threads.create_thread(boost::bind(&WorkerPool::run, this));
+  }
+}
+
+//--------------
+// Destructor --
+//--------------
+WorkerPool::~WorkerPool()
+{
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  m_threads.join_all();
+}
+
+// Add task to the queue
+void
+WorkerPool::submit(const Task& task)
+{
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_tasks.push_back(task);
+  }
+  m_cond.notify_one();
+}
+
+// thread main loop
+void
+WorkerPool::run()
+{
+  while (true) {
+    Task task;
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+      while (m_tasks.empty() and not m_stop) m_cond.wait(lock);
+      if (m_tasks.empty()) return;
+      task.swap(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    try {
+      task();
+    } catch (...) {
+    }
+  }
+}
+
+} // namespace hdf5pp
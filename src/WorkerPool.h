@@ -0,0 +1,90 @@
+#ifndef HDF5PP_WORKERPOOL_H
+#define HDF5PP_WORKERPOOL_H
+
+//--------------------------------------------------------------------------
+// File and Version Information:
+// 	$Id$
+//
+// Description:
+//	Class WorkerPool.
+//
+//------------------------------------------------------------------------
+
+//-----------------
+// C/C++ Headers --
+//-----------------
+#include <deque>
+#include <boost/function.hpp>
+#include <boost/utility.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+//----------------------
+// Base Class Headers --
+//----------------------
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+
+//------------------------------------
+// Collaborating Class Declarations --
+//------------------------------------
+
+//		---------------------
+// 		-- Class Interface --
+//		---------------------
+
+namespace hdf5pp {
+
+/**
+ *  @ingroup hdf5pp
+ *
+ *  @brief Fixed-size pool of threads executing queued tasks.
+ *
+ *  This is an implementation detail of the package. Tasks run outside of
+ *  HDF5 library, they should never call HDF5 functions because HDF5 is not
+ *  guaranteed to be thread-safe. Tasks should not throw, exceptions escaping
+ *  from tasks are ignored.
+ *
+ *  @version $Id$
+ */
+
+class WorkerPool : boost::noncopyable {
+public:
+
+  typedef boost::function<void()> Task;
+
+  /// Start pool, if nThreads is zero then number of hardware threads is used
+  explicit WorkerPool(unsigned nThreads = 0);
+
+  /// Destructor waits for all queued tasks to finish
+  ~WorkerPool();
+
+  /// Add task to the queue
+  void submit(const Task& task);
+
+  /// Number of threads in a pool
+  unsigned size() const { return m_nThreads; }
+
+protected:
+
+private:
+
+  // thread main loop
+  void run();
+
+  // Data members
+  unsigned m_nThreads;
+  bool m_stop;
+  std::deque<Task> m_tasks;
+  boost::mutex m_mutex;
+  boost::condition_variable m_cond;
+  boost::thread_group m_threads;
+
+};
+
+} // namespace hdf5pp
+
+#endif // HDF5PP_WORKERPOOL_H
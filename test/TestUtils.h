@@ -0,0 +1,41 @@
+#ifndef HDF5PP_TEST_TESTUTILS_H
+#define HDF5PP_TEST_TESTUTILS_H
+
+// Helpers shared by the test programs in this directory
+
+#include "hdf5pp/Group.h"
+#include "hdf5pp/Utils.h"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+// helper class to create a test file name
+// for a test, and remove it in the desctructor
+struct TestFile {
+  std::string fname;
+  TestFile(std::string ext="") {
+    fname = std::tmpnam(NULL);
+    if (fname.size()==0) throw std::runtime_error("std::tmpname returned null string");
+    fname += ext;
+  }
+
+  ~TestFile() {
+    if (FILE * f = fopen(fname.c_str(), "r")) {
+      fclose(f);
+      if( 0 != std::remove(fname.c_str())) {
+        perror( "Error deleting file" );
+      }
+    }
+  };
+};
+
+// check that rank-1 int32 dataset has given size and data[i] == i
+inline void check_data(hdf5pp::Group group, const std::string& dataset, int size) {
+  ndarray<int32_t, 1> data = hdf5pp::Utils::readNdarray<int32_t, 1>(group, dataset);
+  if (int(data.size()) != size) throw std::runtime_error("dataset "+dataset+" has unexpected size");
+  for (int i = 0; i != size; ++ i) {
+    if (data.data()[i] != i) throw std::runtime_error("dataset "+dataset+" has unexpected data");
+  }
+}
+
+#endif // HDF5PP_TEST_TESTUTILS_H
@@ -0,0 +1,173 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/DataSetAppender.h"
+#include "hdf5pp/RowAppender.h"
+#include "hdf5pp/Utils.h"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "TestUtils.h"
+
+void test_append() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+
+  // default buffer size, flush on destruction
+  {
+    hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "data", type, 64, 2, 1, true);
+    hdf5pp::Appender<int32_t> app(ds);
+    for (int32_t i = 0; i != 1000; ++ i) app.append(i);
+    if (app.size() != 1000) throw std::runtime_error("appender has unexpected size");
+    if (app.buffered() != 1000 % 64) throw std::runtime_error("appender has unexpected buffer size");
+  }
+
+  // append to existing data, explicit flush, copies share buffer
+  {
+    hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "data2", type, 64, 2, -1, false);
+    for (int32_t i = 0; i != 10; ++ i) hdf5pp::Utils::storeAt(group, "data2", i, -1);
+    hdf5pp::Appender<int32_t> app(ds, 100);
+    hdf5pp::Appender<int32_t> app2 = app;
+    for (int32_t i = 10; i != 300; ++ i) {
+      if (i % 2) app.append(i); else app2.append(i);
+    }
+    app.flush();
+    if (app2.buffered() != 0) throw std::runtime_error("appender copy was not flushed");
+  }
+
+  group.close();
+  h5out.close();
+
+  hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+  group = h5in.openGroup("group");
+  check_data(group, "data", 1000);
+  check_data(group, "data2", 300);
+  group.close();
+  h5in.close();
+}
+
+void test_reserve() {
+  TestFile fname(".h5");
+
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+
+  {
+    hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+    hdf5pp::Group group = h5out.createGroup("group");
+
+    hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "data", type, 16, 2, -1, false);
+    ds.set_reserve(2.0);
+    for (int32_t i = 0; i != 100; ++ i) hdf5pp::Utils::storeAt(group, "data", i, -1);
+    if (ds.size() != 100) throw std::runtime_error("dataset has unexpected logical size");
+    if (ds.dataSpace().size() != 128) throw std::runtime_error("dataset has unexpected physical size");
+    check_data(group, "data", 100);
+
+    // independently opened file sees size stored when extent was last grown,
+    // which only covers written data, and exact size after flush
+    {
+      hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+      hdf5pp::DataSet dsin = h5in.openGroup("group").openDataSet("data");
+      if (dsin.dataSpace().size() != 128) throw std::runtime_error("dataset has unexpected physical size");
+      if (dsin.size() != 65) throw std::runtime_error("reader sees unexpected logical size");
+      check_data(h5in.openGroup("group"), "data", 65);
+      ds.flush();
+      if (dsin.size() != 100) throw std::runtime_error("reader sees stale logical size after flush");
+      check_data(h5in.openGroup("group"), "data", 100);
+      hdf5pp::Utils::storeAt(group, "data", 100, -1);
+      if (ds.dataSpace().size() != 208) throw std::runtime_error("dataset has unexpected physical size");
+      if (dsin.size() != 101) throw std::runtime_error("reader sees stale logical size after growth");
+      check_data(h5in.openGroup("group"), "data", 101);
+    }
+
+    hdf5pp::DataSet ds2 = hdf5pp::Utils::createDataset(group, "data2", type, 16, 2, -1, false);
+    ds2.set_reserve(1.0);
+    hdf5pp::Appender<int32_t> app(ds2, 10);
+    for (int32_t i = 0; i != 55; ++ i) app.append(i);
+    app.flush();
+    if (ds2.dataSpace().size() != 64) throw std::runtime_error("dataset has unexpected physical size");
+    ds2.flush();
+    if (ds2.dataSpace().size() != 55) throw std::runtime_error("dataset was not trimmed");
+
+    // last dataset handles are dropped at the end of the scope, extent is trimmed
+  }
+
+  hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+  hdf5pp::Group group = h5in.openGroup("group");
+  if (group.openDataSet("data").dataSpace().size() != 101) throw std::runtime_error("dataset was not trimmed");
+  check_data(group, "data", 101);
+  check_data(group, "data2", 55);
+  group.close();
+  h5in.close();
+}
+
+void test_rows() {
+  TestFile fname(".h5");
+
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+
+  {
+    hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+    hdf5pp::Group group = h5out.createGroup("group");
+
+    hdf5pp::RowAppender rows;
+    rows.add<int32_t>(hdf5pp::Utils::createDataset(group, "col1", type, 32, 2, -1, false));
+    rows.add<int32_t>(hdf5pp::Utils::createDataset(group, "col2", type, 64, 2, -1, false));
+    rows.add<int32_t>(hdf5pp::Utils::createDataset(group, "col3", type, 16, 2, -1, false));
+    for (int32_t i = 0; i != 250; ++ i) {
+      const void* row[] = { &i, &i, &i };
+      rows.append(row);
+    }
+    if (rows.size() != 250) throw std::runtime_error("row appender has unexpected size");
+    if (rows.buffered() != 250 % 16) throw std::runtime_error("row appender has unexpected buffer size");
+
+    bool thrown = false;
+    try {
+      rows.add<int32_t>(hdf5pp::Utils::createDataset(group, "col4", type, 16, 2, -1, false));
+    } catch (const hdf5pp::Exception& ex) {
+      thrown = true;
+    }
+    if (not thrown) throw std::runtime_error("column was added after rows");
+
+    // failed flush leaves all columns at the last written row
+    hsize_t dims[] = { 0 }, maxdims[] = { 10 };
+    hdf5pp::PListDataSetCreate plist;
+    plist.set_chunk(4);
+    hdf5pp::RowAppender limited(4);
+    limited.add<int32_t>(hdf5pp::Utils::createDataset(group, "ext", type, 4, 2, -1, false));
+    limited.add<int32_t>(group.createDataSet<int32_t>("fixed", hdf5pp::DataSpace::makeSimple(1, dims, maxdims), plist));
+    thrown = false;
+    try {
+      for (int32_t i = 0; i != 12; ++ i) {
+        const void* row[] = { &i, &i };
+        limited.append(row);
+      }
+    } catch (const hdf5pp::Exception& ex) {
+      thrown = true;
+    }
+    if (not thrown) throw std::runtime_error("dataset was extended beyond its maximum size");
+    if (limited.dataSet(0).size() != 8) throw std::runtime_error("column size was not restored");
+    if (limited.dataSet(1).size() != 8) throw std::runtime_error("column has unexpected size");
+  }
+
+  hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+  hdf5pp::Group group = h5in.openGroup("group");
+  check_data(group, "col1", 250);
+  check_data(group, "col2", 250);
+  check_data(group, "col3", 250);
+  check_data(group, "ext", 8);
+  check_data(group, "fixed", 8);
+  group.close();
+  h5in.close();
+}
+
+int main() {
+  test_append();
+  test_reserve();
+  test_rows();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
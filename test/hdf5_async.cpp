@@ -0,0 +1,201 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/AsyncFile.h"
+#include "hdf5pp/Exceptions.h"
+#include "hdf5pp/Utils.h"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include "TestUtils.h"
+
+// gate which blocks a thread until it is opened, used as a deleter of request
+// data to stall I/O thread after it executes a request
+struct Gate {
+  Gate() : open(false), waiting(false) {}
+
+  void operator()(const void* p) {
+    boost::mutex::scoped_lock lock(mutex);
+    waiting = true;
+    cond.notify_all();
+    while (not open) cond.wait(lock);
+    delete [] static_cast<const int32_t*>(p);
+  }
+
+  void release() {
+    boost::mutex::scoped_lock lock(mutex);
+    open = true;
+    cond.notify_all();
+  }
+
+  void waitBlocked() {
+    boost::mutex::scoped_lock lock(mutex);
+    while (not waiting) cond.wait(lock);
+  }
+
+  boost::mutex mutex;
+  boost::condition_variable cond;
+  bool open;
+  bool waiting;
+};
+
+// deleter which forwards to a gate
+struct GateDeleter {
+  GateDeleter(Gate* gate) : gate(gate) {}
+  void operator()(const void* p) const { (*gate)(p); }
+  Gate* gate;
+};
+
+// appends records one by one, counting appended records
+struct Producer {
+  Producer(hdf5pp::AsyncDataSet ds, int32_t first, int32_t count, volatile int* done)
+    : ds(ds), first(first), count(count), done(done) {}
+  void operator()() {
+    for (int32_t i = first; i != first+count; ++ i) {
+      ds.appendCopy(&i, 1);
+      ++ *done;
+    }
+  }
+  hdf5pp::AsyncDataSet ds;
+  int32_t first;
+  int32_t count;
+  volatile int* done;
+};
+
+void test_order() {
+  TestFile fname(".h5");
+  hdf5pp::File file = hdf5pp::File::create(fname.fname, hdf5pp::File::Truncate);
+  hdf5pp::Group group = file.createGroup("group");
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+  hdf5pp::DataSet ds1 = hdf5pp::Utils::createDataset(group, "data", type, 16, 2, -1, false);
+  hsize_t dims[] = { 8 };
+  hdf5pp::DataSet ds2 = group.createDataSet<int32_t>("fixed", hdf5pp::DataSpace::makeSimple(1, dims, dims));
+
+  {
+    hdf5pp::AsyncFile afile(file);
+    hdf5pp::AsyncDataSet ads1 = afile.dataSet(ds1, hdf5pp::TypeTraits<int32_t>::native_type());
+    hdf5pp::AsyncDataSet ads2 = afile.dataSet(ds2, hdf5pp::TypeTraits<int32_t>::native_type());
+
+    // appends of different sizes are executed in the order they are queued
+    for (int32_t i = 0; i < 1000; ) {
+      int32_t count = i % 7 + 1;
+      boost::shared_ptr<int32_t> data(new int32_t[count], boost::checked_array_deleter<int32_t>());
+      for (int32_t k = 0; k != count; ++ k) data.get()[k] = i + k;
+      ads1.append(data, count);
+      i += count;
+    }
+
+    // later stores to the same place overwrite earlier ones
+    std::vector<int32_t> buf(dims[0]);
+    hsize_t offset[] = { 0 };
+    for (int32_t k = 0; k != 10; ++ k) {
+      for (unsigned i = 0; i != buf.size(); ++ i) buf[i] = k == 9 ? int32_t(i) : -1;
+      ads2.storeCopy(&buf.front(), offset, dims);
+    }
+
+    afile.drain();
+    if (afile.queuedBytes() != 0) throw std::runtime_error("queue is not empty after drain");
+  }
+
+  int32_t size = group.openDataSet("data").size();
+  check_data(group, "data", size);
+  if (size < 1000) throw std::runtime_error("appended dataset has unexpected size");
+  check_data(group, "fixed", dims[0]);
+}
+
+void test_backpressure() {
+  TestFile fname(".h5");
+  hdf5pp::File file = hdf5pp::File::create(fname.fname, hdf5pp::File::Truncate);
+  hdf5pp::Group group = file.createGroup("group");
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+  hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "data", type, 16, 2, -1, false);
+
+  Gate gate;
+  {
+    // queue limit is three records
+    const size_t maxBytes = 3*sizeof(int32_t);
+    hdf5pp::AsyncFile afile(file, maxBytes);
+    hdf5pp::AsyncDataSet ads = afile.dataSet(ds, hdf5pp::TypeTraits<int32_t>::native_type());
+
+    // first request stalls I/O thread after it is executed, its size
+    // stays in the queue until it is released
+    int32_t* first = new int32_t[1];
+    first[0] = 0;
+    ads.append(boost::shared_ptr<const void>(first, GateDeleter(&gate)), 1);
+    gate.waitBlocked();
+
+    // producer can queue two more records, then it has to wait
+    volatile int done = 0;
+    boost::thread producer(Producer(ads, 1, 4, &done));
+    while (afile.queuedBytes() < maxBytes) boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+    boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+    if (done != 2) throw std::runtime_error("producer was not blocked by full queue");
+    if (afile.queuedBytes() != maxBytes) throw std::runtime_error("queue has unexpected size");
+
+    gate.release();
+    producer.join();
+    if (done != 4) throw std::runtime_error("producer was not released");
+    afile.drain();
+  }
+
+  check_data(group, "data", 5);
+}
+
+void test_errors() {
+  TestFile fname(".h5");
+  hdf5pp::File file = hdf5pp::File::create(fname.fname, hdf5pp::File::Truncate);
+  hdf5pp::Group group = file.createGroup("group");
+  hsize_t dims[] = { 8 };
+  hdf5pp::DataSet ds = group.createDataSet<int32_t>("fixed", hdf5pp::DataSpace::makeSimple(1, dims, dims));
+
+  // default token is always complete
+  hdf5pp::AsyncToken none;
+  if (not none.done() or none.valid()) throw std::runtime_error("default token is not complete");
+  none.wait();
+
+  hdf5pp::AsyncFile afile(file);
+  hdf5pp::AsyncDataSet ads = afile.dataSet(ds, hdf5pp::TypeTraits<int32_t>::native_type());
+  std::vector<int32_t> buf(dims[0]);
+  for (unsigned i = 0; i != buf.size(); ++ i) buf[i] = i;
+
+  // successful request
+  hsize_t offset[] = { 0 };
+  hdf5pp::AsyncToken token = ads.storeCopy(&buf.front(), offset, dims);
+  token.wait();
+  if (not token.valid() or not token.done()) throw std::runtime_error("token is not complete after wait");
+
+  // request outside of dataset extent fails, failure is reported by the token
+  // and by next drain() only
+  offset[0] = dims[0];
+  hdf5pp::AsyncToken bad = ads.storeCopy(&buf.front(), offset, dims);
+  bool failed = false;
+  try {
+    bad.wait();
+  } catch (const hdf5pp::Exception&) {
+    failed = true;
+  }
+  if (not failed or not bad.done()) throw std::runtime_error("failed request was not reported by token");
+
+  failed = false;
+  try {
+    afile.drain();
+  } catch (const hdf5pp::Exception&) {
+    failed = true;
+  }
+  if (not failed) throw std::runtime_error("failed request was not reported by drain");
+  afile.drain();
+
+  check_data(group, "fixed", dims[0]);
+}
+
+int main() {
+  test_order();
+  test_backpressure();
+  test_errors();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
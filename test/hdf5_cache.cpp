@@ -0,0 +1,122 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/DataSetAppender.h"
+#include "hdf5pp/DataSetCache.h"
+#include "hdf5pp/PathCache.h"
+#include "hdf5pp/Utils.h"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <iostream>
+#include "TestUtils.h"
+
+void test_dataset_cache() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+  hdf5pp::DataSetCache& cache = h5out.dataSetCache();
+  cache.setCapacity(4);
+
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+  char name[16];
+  for (int i = 0; i != 10; ++ i) {
+    snprintf(name, sizeof name, "data%d", i);
+    hdf5pp::Utils::createDataset(group, name, type, 16, 2, -1, false);
+    for (int32_t k = 0; k != i; ++ k) hdf5pp::Utils::storeAt(group, name, k, -1);
+  }
+  if (cache.size() != 4) throw std::runtime_error("dataset cache has unexpected size");
+  if (cache.evictions() != 6) throw std::runtime_error("dataset cache has unexpected number of evictions");
+
+  // evicted datasets are reopened, groups from the same file share the cache
+  hdf5pp::Group group2 = h5out.openGroup("group");
+  unsigned long misses = cache.misses();
+  check_data(group2, "data0", 0);
+  check_data(group2, "/group/data9", 9);
+  if (cache.misses() != misses + 1) throw std::runtime_error("dataset cache has unexpected number of misses");
+
+  // pinned datasets are not evicted: handle used by appender and reserved extent
+  hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "appended", type, 16, 2, -1, false);
+  hdf5pp::Appender<int32_t> app(ds, 100);
+  hdf5pp::Utils::createDataset(group, "reserved", type, 16, 2, -1, false).set_reserve(2.0);
+  for (int32_t i = 0; i != 50; ++ i) {
+    app.append(i);
+    hdf5pp::Utils::storeAt(group, "reserved", i, -1);
+  }
+  for (int i = 0; i != 10; ++ i) {
+    snprintf(name, sizeof name, "data%d", i);
+    check_data(group, name, i);
+  }
+  if (group.openDataSet("appended").id() != ds.id()) throw std::runtime_error("appended dataset was evicted");
+  if (app.buffered() != 50) throw std::runtime_error("appender has unexpected buffer size");
+  app.flush();
+  check_data(group, "appended", 50);
+  check_data(group, "reserved", 50);
+  if (group.openDataSet("reserved").dataSpace().size() != 64) throw std::runtime_error("reserved dataset was evicted");
+}
+
+void test_pinned_order() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("g");
+  hdf5pp::DataSetCache& cache = h5out.dataSetCache();
+  cache.setCapacity(2);
+
+  // pinned dataset is skipped but keeps its place in LRU order
+  hdf5pp::DataSet pinned = group.createDataSet<int32_t>("p", hdf5pp::DataSpace::makeSimple(1, 1));
+  group.createDataSet<int32_t>("u1", hdf5pp::DataSpace::makeSimple(1, 1));
+  group.createDataSet<int32_t>("u2", hdf5pp::DataSpace::makeSimple(1, 1));
+  if (not cache.contains("/g/p") or cache.contains("/g/u1")) throw std::runtime_error("unpinned dataset was not evicted");
+
+  // when released it is the least recently used one
+  pinned = hdf5pp::DataSet();
+  group.createDataSet<int32_t>("u3", hdf5pp::DataSpace::makeSimple(1, 1));
+  if (cache.contains("/g/p") or not cache.contains("/g/u2")) throw std::runtime_error("released dataset was not evicted first");
+
+  // hasChild probes cache without counting lookups
+  unsigned long hits = cache.hits(), misses = cache.misses();
+  if (not group.hasChild("u3") or not group.hasChild("u1")) throw std::runtime_error("hasChild returned unexpected result");
+  if (cache.hits() != hits or cache.misses() != misses) throw std::runtime_error("hasChild changed cache statistics");
+}
+
+void test_path_cache() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::PathCache& cache = h5out.pathCache();
+  hdf5pp::Group top = h5out.createGroup("a");
+  h5out.createGroup("a/b/c").createDataSet<int32_t>("data", hdf5pp::DataSpace::makeSimple(10, 10));
+
+  // repeated lookups, positive and negative, are served from cache
+  if (not top.hasChild("b/c/data")) throw std::runtime_error("hasChild failed to find dataset");
+  if (top.hasChild("b/x/data")) throw std::runtime_error("hasChild found non-existing path");
+  unsigned long misses = cache.misses();
+  if (not top.hasChild("b/c/data") or top.hasChild("b/x/data")) throw std::runtime_error("hasChild returned different result");
+  if (cache.misses() != misses) throw std::runtime_error("path cache was not used");
+
+  // groups opened again are reopened by token and know their paths
+  hdf5pp::Group c1 = h5out.openGroup("/a/b/c");
+  hdf5pp::Group c2 = top.openGroup("b/c");
+  if (c2.name() != "/a/b/c") throw std::runtime_error("group opened from cache has unexpected name");
+  if (c2.parent().name() != "/a/b") throw std::runtime_error("group parent has unexpected name");
+  if (c2.openDataSet("data").dataSpace().size() != 10) throw std::runtime_error("dataset has unexpected size");
+
+  // paths are normalized, same objects have the same names and cache keys
+  hdf5pp::Group b = h5out.openGroup("a//b/");
+  if (b.name() != "/a/b" or b.basename() != "b") throw std::runtime_error("group has non-normalized name");
+  if (b.parent().name() != "/a" or top.parent().name() != "/") throw std::runtime_error("group parent has unexpected name");
+  if (b.openDataSet("c//data").id() != c2.openDataSet("data").id()) throw std::runtime_error("dataset was not found in cache");
+
+  // creating objects through hdf5pp drops negative entries
+  h5out.createGroup("a/b/x").createDataSet<int32_t>("data", hdf5pp::DataSpace::makeSimple(10, 10));
+  if (not top.hasChild("b/x/data")) throw std::runtime_error("hasChild failed to find new dataset");
+  if (top.hasChild("link")) throw std::runtime_error("hasChild found non-existing link");
+  top.makeSoftLink("/a/b/x", "link");
+  if (not top.hasChild("link/data")) throw std::runtime_error("hasChild failed to find new link");
+}
+
+int main() {
+  test_dataset_cache();
+  test_pinned_order();
+  test_path_cache();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,237 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/Catalog.h"
+#include "hdf5pp/Exceptions.h"
+#include "hdf5pp/FileIndex.h"
+#include "hdf5pp/Utils.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "TestUtils.h"
+
+std::string read_file(const std::string& fname) {
+  std::ifstream in(fname.c_str(), std::ios::binary);
+  std::ostringstream str;
+  str << in.rdbuf();
+  return str.str();
+}
+
+void write_file(const std::string& fname, const std::string& data) {
+  std::ofstream out(fname.c_str(), std::ios::binary);
+  out << data;
+  if (not out) throw std::runtime_error("failed to write file " + fname);
+}
+
+void make_catalog_file(const std::string& fname, int nevents) {
+  hdf5pp::File h5out = hdf5pp::File::create(fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("Run:0000/CalibCycle:0000");
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+  hdf5pp::Utils::createDataset(group, "data", type, 16, 2, 1, true);
+  for (int32_t i = 0; i != nevents; ++ i) hdf5pp::Utils::storeAt(group, "data", i, -1);
+  group.createDataSet<double>("scalar", hdf5pp::DataSpace::makeScalar());
+}
+
+void check_catalog(const hdf5pp::Catalog& catalog, uint32_t file, hsize_t nevents) {
+  const char* paths[] = { "/", "/Run:0000", "/Run:0000/CalibCycle:0000" };
+  for (int i = 0; i != 3; ++ i) {
+    const hdf5pp::Catalog::Object* obj = catalog.find(paths[i], file);
+    if (not obj or obj->type != H5O_TYPE_GROUP) throw std::runtime_error("catalog has no group");
+  }
+  if (catalog.find("/Run:0000/missing", file)) throw std::runtime_error("catalog has unexpected object");
+
+  const hdf5pp::Catalog::Object* obj = catalog.find("/Run:0000/CalibCycle:0000/data", file);
+  if (not obj or obj->type != H5O_TYPE_DATASET) throw std::runtime_error("catalog has no dataset");
+  if (obj->typeClass != H5T_INTEGER or obj->typeSize != 4) throw std::runtime_error("catalog has unexpected data type");
+  std::vector<hsize_t> dims = catalog.dims(*obj);
+  if (dims.size() != 1 or dims[0] != nevents) throw std::runtime_error("catalog has unexpected dimensions");
+  std::vector<hsize_t> chunk = catalog.chunkDims(*obj);
+  if (chunk.size() != 1 or chunk[0] != 16) throw std::runtime_error("catalog has unexpected chunk dimensions");
+  std::vector<H5Z_filter_t> filters = catalog.filters(*obj);
+  if (filters.size() != 2 or filters[0] != H5Z_FILTER_SHUFFLE or filters[1] != H5Z_FILTER_DEFLATE) {
+    throw std::runtime_error("catalog has unexpected filters");
+  }
+  if (obj->storageSize == 0) throw std::runtime_error("catalog has unexpected storage size");
+
+  obj = catalog.find("/Run:0000/CalibCycle:0000/scalar", file);
+  if (not obj or obj->rank != 0 or obj->chunked or obj->typeClass != H5T_FLOAT) {
+    throw std::runtime_error("catalog has unexpected scalar dataset");
+  }
+}
+
+// returns true if reading of modified catalog data throws, data
+// are truncated at offset if bytes is zero
+bool read_fails(std::string data, size_t offset, const void* bytes, size_t size) {
+  if (bytes) data.replace(offset, size, static_cast<const char*>(bytes), size);
+  else data.resize(offset);
+  std::istringstream str(data);
+  try {
+    hdf5pp::Catalog::read(str);
+  } catch (const hdf5pp::Exception&) {
+    return true;
+  }
+  return false;
+}
+
+void test_corrupted(const hdf5pp::Catalog& catalog) {
+  std::ostringstream str;
+  catalog.write(str);
+  const std::string data = str.str();
+
+  // any truncation is detected
+  for (size_t size = 0; size != data.size(); ++ size) {
+    if (not read_fails(data, size, 0, 0)) throw std::runtime_error("truncated catalog was read");
+  }
+
+  // header: magic, version and byte order mark, one file name, number of objects
+  const size_t header = sizeof "hdf5pp.Catalog" + 2*sizeof(uint32_t);
+  const size_t nobjects = header + sizeof(uint32_t) + sizeof(uint32_t) + catalog.files()[0].size();
+  // first object is the root group with path "/"
+  const size_t obj = nobjects + sizeof(uint64_t);
+  const size_t file = obj + sizeof(uint32_t) + 1;
+  const size_t rank = file + 2*sizeof(uint32_t) + sizeof(hdf5pp::PathCache::Token) + 2*sizeof(uint32_t);
+
+  const uint64_t huge = uint64_t(1) << 40;
+  const uint32_t badFile = 7;
+  const uint8_t badRank = H5S_MAX_RANK + 1, badDims = 3, badFilters = 9, badChunked = 2;
+  if (not read_fails(data, nobjects, &huge, sizeof huge)) throw std::runtime_error("bad object count was accepted");
+  if (not read_fails(data, file, &badFile, sizeof badFile)) throw std::runtime_error("bad file index was accepted");
+  if (not read_fails(data, rank, &badRank, 1)) throw std::runtime_error("bad rank was accepted");
+  if (not read_fails(data, rank, &badDims, 1)) throw std::runtime_error("bad dimensions index was accepted");
+  if (not read_fails(data, rank+1, &badFilters, 1)) throw std::runtime_error("bad filters index was accepted");
+  if (not read_fails(data, rank+2, &badChunked, 1)) throw std::runtime_error("bad chunked flag was accepted");
+  if (read_fails(data, rank+2, &data[rank+2], 1)) throw std::runtime_error("valid catalog was not read");
+}
+
+void test_catalog() {
+  TestFile fname1(".h5");
+  TestFile fname2(".h5");
+  make_catalog_file(fname1.fname, 100);
+  make_catalog_file(fname2.fname, 50);
+
+  hdf5pp::Catalog catalog = hdf5pp::Catalog::scan(hdf5pp::File::open(fname1.fname, hdf5pp::File::Read));
+  if (catalog.size() != 5 or catalog.files().size() != 1) throw std::runtime_error("catalog has unexpected size");
+  check_catalog(catalog, 0, 100);
+
+  // binary round trip
+  std::stringstream str;
+  catalog.write(str);
+  hdf5pp::Catalog copy = hdf5pp::Catalog::read(str);
+  if (copy.size() != 5 or copy.files() != catalog.files()) throw std::runtime_error("catalog copy has unexpected size");
+  check_catalog(copy, 0, 100);
+  test_corrupted(catalog);
+
+  // concurrent scan in child processes
+  std::vector<std::string> paths;
+  paths.push_back(fname1.fname);
+  paths.push_back(fname2.fname);
+  paths.push_back(fname1.fname);
+  hdf5pp::Catalog merged = hdf5pp::Catalog::scan(paths, 2);
+  if (merged.size() != 15 or merged.files().size() != 3) throw std::runtime_error("merged catalog has unexpected size");
+  check_catalog(merged, 0, 100);
+  check_catalog(merged, 1, 50);
+  check_catalog(merged, 2, 100);
+
+  paths.push_back("/nonexistent/file.h5");
+  bool failed = false;
+  try {
+    hdf5pp::Catalog::scan(paths, 2);
+  } catch (const hdf5pp::Exception& ex) {
+    failed = true;
+  }
+  if (not failed) throw std::runtime_error("scan of missing file did not fail");
+}
+
+void test_file_index() {
+  TestFile fname(".h5");
+  TestFile iname(".h5.idx");
+  iname.fname = hdf5pp::FileIndex::indexPath(fname.fname);
+  make_catalog_file(fname.fname, 100);
+
+  hdf5pp::Catalog catalog;
+  if (hdf5pp::FileIndex::read(fname.fname, catalog)) throw std::runtime_error("index should not exist yet");
+  if (hdf5pp::File::open(fname.fname, hdf5pp::File::Read).catalog().size() != 0) {
+    throw std::runtime_error("file without index has non-empty catalog");
+  }
+
+  hdf5pp::FileIndex::create(fname.fname);
+  if (not hdf5pp::FileIndex::read(fname.fname, catalog)) throw std::runtime_error("failed to read index");
+  check_catalog(catalog, 0, 100);
+
+  // lookups are served from index
+  {
+    hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+    check_catalog(h5in.catalog(), 0, 100);
+    hdf5pp::PathCache& cache = h5in.pathCache();
+    unsigned long misses = cache.misses();
+    hdf5pp::Group group = h5in.openGroup("Run:0000/CalibCycle:0000");
+    if (not h5in.openGroup("/").hasChild("Run:0000/CalibCycle:0000/data")) throw std::runtime_error("hasChild failed");
+    if (cache.misses() != misses) throw std::runtime_error("lookups were not served from index");
+    if (cache.size() != 0) throw std::runtime_error("index was copied into path cache");
+    check_data(group, "data", 100);
+  }
+
+  std::string index = read_file(iname.fname);
+
+  // damaged index is ignored
+  write_file(iname.fname, index.substr(0, index.size() - 5));
+  if (hdf5pp::FileIndex::read(fname.fname, catalog) or catalog.size() != 0) {
+    throw std::runtime_error("truncated index was read");
+  }
+  if (hdf5pp::File::open(fname.fname, hdf5pp::File::Read).catalog().size() != 0) {
+    throw std::runtime_error("file uses truncated index");
+  }
+  std::string damaged = index;
+  damaged[damaged.size() - 16] = 0x7f;
+  write_file(iname.fname, damaged);
+  {
+    hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+    if (h5in.catalog().size() != 0) throw std::runtime_error("file uses damaged index");
+    check_data(h5in.openGroup("Run:0000/CalibCycle:0000"), "data", 100);
+  }
+
+  // index which passes validation but has wrong tokens, groups are opened by path
+  {
+    TestFile oname(".h5");
+    TestFile oiname(".h5.idx");
+    oiname.fname = hdf5pp::FileIndex::indexPath(oname.fname);
+    {
+      // same paths at different places in file
+      hdf5pp::File h5out = hdf5pp::File::create(oname.fname, hdf5pp::File::Truncate);
+      h5out.createGroup("other").createDataSet<double>("scalar", hdf5pp::DataSpace::makeScalar());
+      h5out.createGroup("Run:0000/CalibCycle:0000");
+    }
+    hdf5pp::FileIndex::create(oname.fname);
+    // stamp of this file and catalog of the other one
+    std::string other = read_file(oiname.fname);
+    write_file(iname.fname, index.substr(0, index.find("hdf5pp.Catalog")) + other.substr(other.find("hdf5pp.Catalog")));
+  }
+  {
+    hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+    if (h5in.catalog().size() == 0) throw std::runtime_error("index with wrong tokens was not loaded");
+    hdf5pp::Group group = h5in.openGroup("Run:0000/CalibCycle:0000");
+    if (group.name() != "/Run:0000/CalibCycle:0000") throw std::runtime_error("group has unexpected name");
+    check_data(group, "data", 100);
+  }
+  write_file(iname.fname, index);
+
+  // modified file does not use old index
+  {
+    hdf5pp::File h5out = hdf5pp::File::open(fname.fname, hdf5pp::File::Update);
+    hdf5pp::Utils::storeAt(h5out.openGroup("Run:0000/CalibCycle:0000"), "data", int32_t(100), -1);
+  }
+  if (hdf5pp::FileIndex::read(fname.fname, catalog)) throw std::runtime_error("index of modified file is valid");
+  if (hdf5pp::File::open(fname.fname, hdf5pp::File::Read).catalog().size() != 0) {
+    throw std::runtime_error("modified file uses old index");
+  }
+}
+
+int main() {
+  test_catalog();
+  test_file_index();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
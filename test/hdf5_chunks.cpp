@@ -0,0 +1,291 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/ChunkReader.h"
+#include "hdf5pp/ChunkWriter.h"
+#include "hdf5pp/FilterPipeline.h"
+#include "hdf5pp/PrecisionType.h"
+#include "hdf5pp/Utils.h"
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "TestUtils.h"
+
+const unsigned NROWS = 100;
+const unsigned NCOLS = 60;
+const hsize_t CHUNK[] = { 32, 32 };
+
+int16_t value(unsigned row, unsigned col) { return int16_t(row*NCOLS + col) % 1000; }
+
+hdf5pp::DataSet make_dataset(hdf5pp::Group group, const std::string& name) {
+  hdf5pp::PListDataSetCreate plDScreate;
+  plDScreate.set_chunk(2, CHUNK);
+  plDScreate.set_shuffle();
+  plDScreate.set_deflate(1);
+  hsize_t dims[] = { NROWS, NCOLS };
+  hdf5pp::DataSpace dsp = hdf5pp::DataSpace::makeSimple(2, dims, dims);
+  return group.createDataSet<int16_t>(name, dsp, plDScreate);
+}
+
+void check_data(hdf5pp::Group group, const std::string& dataset) {
+  ndarray<int16_t, 2> data = hdf5pp::Utils::readNdarray<int16_t, 2>(group, dataset);
+  if (data.shape()[0] != NROWS or data.shape()[1] != NCOLS) {
+    throw std::runtime_error("dataset "+dataset+" has unexpected shape");
+  }
+  for (unsigned row = 0; row != NROWS; ++ row) {
+    for (unsigned col = 0; col != NCOLS; ++ col) {
+      if (data.data()[row*NCOLS + col] != value(row, col)) {
+        throw std::runtime_error("dataset "+dataset+" has unexpected data");
+      }
+    }
+  }
+}
+
+void test_write_chunk() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  hdf5pp::DataSet ds = make_dataset(group, "data");
+  hsize_t chunk[2];
+  if (ds.chunkDims(chunk) != 2 or chunk[0] != CHUNK[0] or chunk[1] != CHUNK[1]) {
+    throw std::runtime_error("unexpected chunk dimensions");
+  }
+
+  hdf5pp::FilterPipeline pipeline(ds);
+  if (not pipeline.supported()) throw std::runtime_error("pipeline is not supported");
+
+  // edge chunks are written in full size, outside elements are ignored
+  std::vector<int16_t> buf(CHUNK[0]*CHUNK[1]);
+  std::vector<char> encoded;
+  for (hsize_t r0 = 0; r0 < NROWS; r0 += CHUNK[0]) {
+    for (hsize_t c0 = 0; c0 < NCOLS; c0 += CHUNK[1]) {
+      for (unsigned r = 0; r != CHUNK[0]; ++ r) {
+        for (unsigned c = 0; c != CHUNK[1]; ++ c) {
+          buf[r*CHUNK[1] + c] = value(r0+r, c0+c);
+        }
+      }
+      uint32_t mask = pipeline.encode(&buf.front(), buf.size()*sizeof buf[0], encoded);
+      hsize_t offset[] = { r0, c0 };
+      ds.writeChunk(offset, mask, &encoded.front(), encoded.size());
+    }
+  }
+
+  group.close();
+  h5out.close();
+
+  hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+  group = h5in.openGroup("group");
+  check_data(group, "data");
+  group.close();
+  h5in.close();
+}
+
+void test_chunk_writer() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  // rank-2 array
+  hdf5pp::DataSet ds = make_dataset(group, "data");
+  unsigned shape[] = { NROWS, NCOLS };
+  ndarray<int16_t, 2> array(shape);
+  for (unsigned row = 0; row != NROWS; ++ row) {
+    for (unsigned col = 0; col != NCOLS; ++ col) {
+      array.data()[row*NCOLS + col] = value(row, col);
+    }
+  }
+  {
+    hdf5pp::ChunkWriter writer(ds, hdf5pp::TypeTraits<int16_t>::native_type(), 3);
+    writer.write(array);
+  }
+
+  // rank-1 records, with intermediate flush of incomplete chunk
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+  hdf5pp::DataSet ds1 = hdf5pp::Utils::createDataset(group, "data1", type, 50, 2, 1, true);
+  std::vector<int32_t> records(1000);
+  for (unsigned i = 0; i != records.size(); ++ i) records[i] = i;
+  hdf5pp::ChunkWriter writer(ds1, hdf5pp::TypeTraits<int32_t>::native_type(), 2, 3);
+  writer.append(&records[0], 123);
+  writer.flush();
+  if (ds1.size() != 123) throw std::runtime_error("unexpected dataset size after flush");
+  writer.append(&records[123], 700);
+  writer = hdf5pp::ChunkWriter();
+
+  // continue appending after incomplete chunk
+  writer = hdf5pp::ChunkWriter(ds1, hdf5pp::TypeTraits<int32_t>::native_type(), 2);
+  writer.append(&records[823], 177);
+  writer.flush();
+
+  group.close();
+  h5out.close();
+
+  hdf5pp::File h5in = hdf5pp::File::open(fname.fname, hdf5pp::File::Read);
+  group = h5in.openGroup("group");
+  check_data(group, "data");
+  ndarray<int32_t, 1> data1 = hdf5pp::Utils::readNdarray<int32_t, 1>(group, "data1");
+  if (data1.size() != records.size()) throw std::runtime_error("dataset data1 has unexpected size");
+  if (not std::equal(records.begin(), records.end(), data1.data())) {
+    throw std::runtime_error("dataset data1 has unexpected data");
+  }
+  group.close();
+  h5in.close();
+}
+
+void test_chunk_reader() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  // only first rows are written, remaining chunks have no storage
+  hdf5pp::DataSet ds = make_dataset(group, "data");
+  const unsigned nrows = 40;
+  std::vector<int16_t> rows(nrows*NCOLS);
+  for (unsigned row = 0; row != nrows; ++ row) {
+    for (unsigned col = 0; col != NCOLS; ++ col) rows[row*NCOLS + col] = value(row, col);
+  }
+  hsize_t start[] = { 0, 0 };
+  hsize_t count[] = { nrows, NCOLS };
+  hdf5pp::DataSpace fileDsp = ds.dataSpace();
+  fileDsp.select_hyperslab(H5S_SELECT_SET, start, 0, count, 0);
+  ds.store(hdf5pp::DataSpace::makeSimple(2, count, count), fileDsp, &rows[0]);
+
+  // rank-1 dataset with reserved extent
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+  hdf5pp::DataSet ds1 = hdf5pp::Utils::createDataset(group, "data1", type, 64, 2, 1, true);
+  ds1.set_reserve(2.0);
+  for (int32_t i = 0; i != 1000; ++ i) hdf5pp::Utils::storeAt(group, "data1", i, -1);
+
+  hdf5pp::ChunkReader reader(ds, 3, 2);
+  if (not reader.supported(hdf5pp::TypeTraits<int16_t>::native_type())) {
+    throw std::runtime_error("parallel read is not supported");
+  }
+  if (reader.supported(hdf5pp::TypeTraits<int32_t>::native_type())) {
+    throw std::runtime_error("parallel read with type conversion is supported");
+  }
+  ndarray<int16_t, 2> data = reader.read<int16_t, 2>();
+  ndarray<int16_t, 2> expected = hdf5pp::Utils::readNdarray<int16_t, 2>(ds);
+  if (data.shape()[0] != NROWS or data.shape()[1] != NCOLS) throw std::runtime_error("unexpected shape");
+  if (not std::equal(data.begin(), data.end(), expected.begin())) throw std::runtime_error("unexpected data");
+
+  ndarray<int32_t, 1> data1 = hdf5pp::Utils::readNdarrayParallel<int32_t, 1>(ds1, 2);
+  if (data1.size() != 1000) throw std::runtime_error("dataset data1 has unexpected size");
+  for (unsigned i = 0; i != data1.size(); ++ i) {
+    if (data1.data()[i] != int32_t(i)) throw std::runtime_error("dataset data1 has unexpected data");
+  }
+
+  // read into existing object, array and raw buffer
+  int32_t value = -1;
+  hdf5pp::Utils::readDataSetInto(ds1, &value, 7);
+  if (value != 7 or *hdf5pp::Utils::readDataSet<int32_t>(ds1, 0) != 0) throw std::runtime_error("unexpected value");
+  hdf5pp::Utils::readNdarray(ds, data);
+  if (not std::equal(data.begin(), data.end(), expected.begin())) throw std::runtime_error("unexpected data");
+  std::vector<int16_t> buf(NROWS*NCOLS);
+  unsigned shape[2];
+  if (hdf5pp::Utils::readNdarray<int16_t, 2>(ds, &buf[0], buf.size(), shape) != buf.size() or
+      shape[0] != NROWS or shape[1] != NCOLS) throw std::runtime_error("unexpected shape");
+  bool thrown = false;
+  try {
+    hdf5pp::Utils::readNdarray<int16_t, 2>(ds, &buf[0], buf.size()-1, shape);
+  } catch (const hdf5pp::Exception& ex) {
+    thrown = true;
+  }
+  if (not thrown) throw std::runtime_error("buffer overflow was not detected");
+
+  // falls back to H5Dread with type conversion
+  ndarray<double, 1> data2 = hdf5pp::Utils::readNdarrayParallel<double, 1>(ds1);
+  if (data2.size() != 1000 or data2.data()[999] != 999.) throw std::runtime_error("unexpected converted data");
+}
+
+void test_map_view() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  // contiguous dataset can be mapped, chunked cannot
+  unsigned shape[] = { NROWS, NCOLS };
+  ndarray<int16_t, 2> array(shape);
+  for (unsigned row = 0; row != NROWS; ++ row) {
+    for (unsigned col = 0; col != NCOLS; ++ col) array.data()[row*NCOLS + col] = value(row, col);
+  }
+  hdf5pp::Utils::storeNDArray(group, "contig", array);
+  if (make_dataset(group, "data").mappable(hdf5pp::TypeTraits<int16_t>::native_type())) {
+    throw std::runtime_error("chunked dataset is mappable");
+  }
+
+  ndarray<const int16_t, 2> view;
+  {
+    hdf5pp::DataSet ds = group.openDataSet("contig");
+    if (not ds.mappable(hdf5pp::TypeTraits<int16_t>::native_type())) throw std::runtime_error("dataset is not mappable");
+    if (ds.mappable(hdf5pp::TypeTraits<int32_t>::native_type())) throw std::runtime_error("dataset is mappable with conversion");
+    view = ds.mapView<int16_t, 2>();
+  }
+  group.close();
+  h5out.close();
+
+  // mapping outlives dataset and file
+  if (view.shape()[0] != NROWS or view.shape()[1] != NCOLS) throw std::runtime_error("unexpected shape");
+  if (not std::equal(view.begin(), view.end(), array.begin())) throw std::runtime_error("unexpected data");
+}
+
+void test_precision() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  unsigned shape[] = { NROWS, NCOLS };
+  ndarray<float, 2> array(shape);
+  for (unsigned i = 0; i != NROWS*NCOLS; ++ i) array.data()[i] = std::sin(i*0.01) * 1000;
+  ndarray<uint16_t, 2> iarray(shape);
+  for (unsigned i = 0; i != NROWS*NCOLS; ++ i) iarray.data()[i] = i % 4096;
+
+  hdf5pp::PListDataSetCreate plist;
+  plist.set_chunk(2, CHUNK);
+  plist.set_nbit();
+
+  hdf5pp::Type native = hdf5pp::TypeTraits<float>::native_type();
+  hdf5pp::Utils::storeNDArray(group, "half", array, native, hdf5pp::PrecisionType::float16(), plist);
+  hdf5pp::Utils::storeNDArray(group, "trunc", array, native, hdf5pp::PrecisionType::truncatedFloat(10), plist);
+  hdf5pp::Utils::storeNDArray(group, "int12", iarray, hdf5pp::TypeTraits<uint16_t>::native_type(),
+      hdf5pp::PrecisionType::integerType(hdf5pp::TypeTraits<uint16_t>::stored_type(), 12), plist);
+
+  if (hdf5pp::PrecisionType::float16().size() != 2) throw std::runtime_error("float16 has unexpected size");
+  if (hdf5pp::PrecisionType::float16().id() != hdf5pp::PrecisionType::float16().id()) {
+    throw std::runtime_error("float16 type is not cached");
+  }
+
+  // n-bit filter packs 19 bits of truncated float and 12 bits of integer,
+  // storage is allocated for 8 full chunks
+  const hsize_t nchunked = 8*CHUNK[0]*CHUNK[1];
+  if (H5Dget_storage_size(group.openDataSet("trunc").id()) > nchunked*19/8 + 1024) {
+    throw std::runtime_error("truncated float is not packed");
+  }
+  if (H5Dget_storage_size(group.openDataSet("int12").id()) > nchunked*12/8 + 1024) {
+    throw std::runtime_error("12-bit integer is not packed");
+  }
+
+  // relative precision is 2^-11 for both float types
+  const char* names[] = { "half", "trunc" };
+  for (int k = 0; k != 2; ++ k) {
+    ndarray<float, 2> data = hdf5pp::Utils::readNdarray<float, 2>(group, names[k]);
+    for (unsigned i = 0; i != NROWS*NCOLS; ++ i) {
+      if (std::fabs(data.data()[i] - array.data()[i]) > std::fabs(array.data()[i]) / 1024) {
+        throw std::runtime_error(std::string("dataset ") + names[k] + " has unexpected data");
+      }
+    }
+  }
+  ndarray<uint16_t, 2> idata = hdf5pp::Utils::readNdarray<uint16_t, 2>(group, "int12");
+  if (not std::equal(idata.begin(), idata.end(), iarray.begin())) throw std::runtime_error("int12 has unexpected data");
+}
+
+int main() {
+  test_write_chunk();
+  test_chunk_writer();
+  test_chunk_reader();
+  test_map_view();
+  test_precision();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/CompoundTraits.h"
+#include "hdf5pp/DataSetAppender.h"
+#include "hdf5pp/TypeCache.h"
+#include "hdf5pp/Utils.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "TestUtils.h"
+
+namespace test {
+struct Record {
+  int8_t flag;
+  double pos[3];
+  int16_t id;
+};
+}
+HDF5PP_COMPOUND(test::Record, (flag)(pos)(id))
+
+// make dataset with 100 records, record i has id i and flag i%2
+hdf5pp::DataSet make_records(hdf5pp::Group group) {
+  hdf5pp::Type stored = hdf5pp::TypeTraits<test::Record>::stored_type();
+  hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "data", stored, 16, 2, -1, false);
+  hdf5pp::Appender<test::Record> app(ds);
+  for (int i = 0; i != 100; ++ i) {
+    test::Record rec = { int8_t(i % 2), { i*1., i*2., i*3. }, int16_t(i) };
+    app.append(rec);
+  }
+  return ds;
+}
+
+void test_read_fields() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::DataSet ds = make_records(h5out.createGroup("group"));
+
+  // read only one member of records 10-19, other members are not touched
+  hdf5pp::Type native = hdf5pp::TypeTraits<test::Record>::native_type();
+  std::vector<std::string> fields(1, "id");
+  if (hdf5pp::TypeCache::subsetType(native, fields).id() != hdf5pp::TypeCache::subsetType(native, fields).id()) {
+    throw std::runtime_error("subset type is not cached");
+  }
+  test::Record recs[10];
+  for (int i = 0; i != 10; ++ i) recs[i].flag = 42;
+  hdf5pp::DataSpace fileDsp = ds.dataSpace();
+  hsize_t offset[] = { 10 };
+  hsize_t count[] = { 10 };
+  fileDsp.select_hyperslab(H5S_SELECT_SET, offset, 0, count, 0);
+  ds.readFields(fields, hdf5pp::DataSpace::makeSimple(10, 10), fileDsp, recs);
+  for (int i = 0; i != 10; ++ i) {
+    if (recs[i].id != 10+i or recs[i].flag != 42) throw std::runtime_error("readFields returned unexpected data");
+  }
+}
+
+void test_read_columns() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::DataSet ds = make_records(h5out.createGroup("group"));
+
+  // columns for a range crossing chunk boundaries
+  ndarray<int16_t, 1> ids;
+  ndarray<int8_t, 1> flags;
+  hdf5pp::Columns columns;
+  columns.add("id", ids).add("flag", flags);
+  if (hdf5pp::Utils::readColumns(ds, columns, 5, 90) != 90) throw std::runtime_error("readColumns returned unexpected count");
+  if (ids.size() != 90 or flags.size() != 90) throw std::runtime_error("readColumns returned unexpected size");
+  for (int i = 0; i != 90; ++ i) {
+    if (ids.data()[i] != 5+i or flags.data()[i] != (5+i) % 2) throw std::runtime_error("readColumns returned unexpected data");
+  }
+}
+
+int main() {
+  test_read_fields();
+  test_read_columns();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,111 @@
+#include "hdf5pp/Conversions.h"
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+// Compares results and speed of HDF5 built-in conversions with conversions
+// registered by hdf5pp::Conversions::init().
+
+namespace {
+
+const size_t nelem = 1 << 22;
+const int nrepeat = 5;
+
+double now() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+struct Case {
+  Case(const std::string& name, hid_t src, hid_t dst)
+    : name(name), src(src), dst(dst), input(), result(), time(0) {}
+
+  std::string name;
+  hid_t src;
+  hid_t dst;
+  std::vector<char> input;
+  std::vector<char> result;
+  double time;
+};
+
+// fill buffer with values of source type
+void fill(Case& c) {
+  size_t srcSize = H5Tget_size(c.src);
+  size_t dstSize = H5Tget_size(c.dst);
+  // buffer must fit values in double, source and destination types
+  std::vector<char> buf(nelem * std::max(size_t(8), std::max(srcSize, dstSize)));
+  if (H5Tget_class(c.src) == H5T_FLOAT) {
+    for (size_t i = 0; i != nelem; ++ i) {
+      double v = (double(i) - nelem/2) * 1.25;
+      std::memcpy(&buf[i*8], &v, 8);
+    }
+    if (H5Tconvert(H5T_NATIVE_DOUBLE, c.src, nelem, &buf.front(), 0, H5P_DEFAULT) < 0) throw std::runtime_error("H5Tconvert failed");
+  } else {
+    for (size_t i = 0; i != nelem; ++ i) {
+      uint16_t v = uint16_t(i * 7919);
+      std::memcpy(&buf[i*2], &v, 2);
+    }
+    if (H5Tconvert(H5T_NATIVE_UINT16, c.src, nelem, &buf.front(), 0, H5P_DEFAULT) < 0) throw std::runtime_error("H5Tconvert failed");
+  }
+  buf.resize(nelem * std::max(srcSize, dstSize));
+  c.input = buf;
+}
+
+// run conversion several times, return best time
+double run(Case& c, std::vector<char>& result) {
+  double best = 0;
+  for (int i = 0; i != nrepeat; ++ i) {
+    result = c.input;
+    double t0 = now();
+    if (H5Tconvert(c.src, c.dst, nelem, &result.front(), 0, H5P_DEFAULT) < 0) throw std::runtime_error("H5Tconvert failed");
+    double t = now() - t0;
+    if (i == 0 or t < best) best = t;
+  }
+  result.resize(nelem * H5Tget_size(c.dst));
+  return best;
+}
+
+}
+
+int main() {
+  bool le = H5Tget_order(H5T_NATIVE_INT) == H5T_ORDER_LE;
+  Case cases[] = {
+    Case("int16 swap", le ? H5T_STD_I16BE : H5T_STD_I16LE, H5T_NATIVE_INT16),
+    Case("int32 swap", le ? H5T_STD_I32BE : H5T_STD_I32LE, H5T_NATIVE_INT32),
+    Case("int64 swap", le ? H5T_STD_I64BE : H5T_STD_I64LE, H5T_NATIVE_INT64),
+    Case("float swap", le ? H5T_IEEE_F32BE : H5T_IEEE_F32LE, H5T_NATIVE_FLOAT),
+    Case("double swap", le ? H5T_IEEE_F64BE : H5T_IEEE_F64LE, H5T_NATIVE_DOUBLE),
+    Case("int16 -> float", H5T_NATIVE_INT16, H5T_NATIVE_FLOAT),
+    Case("uint16 -> int32", H5T_NATIVE_UINT16, H5T_NATIVE_INT32),
+    Case("double -> float", H5T_NATIVE_DOUBLE, H5T_NATIVE_FLOAT),
+    Case("swapped int16 -> float", le ? H5T_STD_I16BE : H5T_STD_I16LE, H5T_NATIVE_FLOAT),
+  };
+  const size_t ncases = sizeof cases / sizeof cases[0];
+
+  // HDF5 built-in conversions
+  for (size_t i = 0; i != ncases; ++ i) {
+    fill(cases[i]);
+    cases[i].time = run(cases[i], cases[i].result);
+  }
+
+  hdf5pp::Conversions::init();
+
+  std::cout << std::setw(24) << std::left << "conversion" << std::right
+            << std::setw(12) << "HDF5, ms" << std::setw(12) << "hdf5pp, ms" << std::setw(10) << "speedup" << '\n';
+  for (size_t i = 0; i != ncases; ++ i) {
+    std::vector<char> result;
+    double time = run(cases[i], result);
+    if (result != cases[i].result) throw std::runtime_error("conversion result differs for " + cases[i].name);
+    std::cout << std::setw(24) << std::left << cases[i].name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << cases[i].time*1e3 << std::setw(12) << time*1e3
+              << std::setw(10) << cases[i].time/time << '\n';
+  }
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/GroupIter.h"
+#include "hdf5pp/LinkEntry.h"
+#include "hdf5pp/NameIter.h"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "TestUtils.h"
+
+void test_link_iter() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group top = h5out.createGroup("top");
+  top.createGroup("g1");
+  top.createGroup("g2").createGroup("sub");
+  top.createDataSet<int32_t>("data", hdf5pp::DataSpace::makeSimple(10, 10));
+  top.makeSoftLink("/top/g2", "soft");
+  top.makeSoftLink("/top/missing", "dangling");
+
+  // names come in the same order as before, objects types are known without opening them
+  const char* names[] = { "dangling", "data", "g1", "g2", "soft" };
+  const H5O_type_t types[] = { H5O_TYPE_UNKNOWN, H5O_TYPE_DATASET, H5O_TYPE_GROUP, H5O_TYPE_GROUP, H5O_TYPE_GROUP };
+  hdf5pp::NameIter niter(top);
+  for (int i = 0; i != 5; ++ i) {
+    const hdf5pp::LinkEntry* entry = niter.nextEntry();
+    if (not entry or entry->name != names[i]) throw std::runtime_error("NameIter returned unexpected name");
+    if (entry->objType != types[i]) throw std::runtime_error("NameIter returned unexpected object type");
+  }
+  if (niter.nextEntry() or not niter.next().empty()) throw std::runtime_error("NameIter returned too many names");
+
+  hdf5pp::NameIter hard(top, hdf5pp::NameIter::HardLink);
+  if (hard.next() != "data" or hard.next() != "g1" or hard.next() != "g2" or not hard.next().empty()) {
+    throw std::runtime_error("NameIter returned unexpected hard links");
+  }
+
+  // soft link to a group is returned as a group too
+  std::vector<std::string> groups;
+  hdf5pp::GroupIter giter(top);
+  for (hdf5pp::Group grp = giter.next(); grp.valid(); grp = giter.next()) groups.push_back(grp.name());
+  if (groups.size() != 3 or groups[0] != "/top/g1" or groups[1] != "/top/g2" or groups[2] != "/top/soft") {
+    throw std::runtime_error("GroupIter returned unexpected groups");
+  }
+  hdf5pp::GroupIter hiter(top, hdf5pp::GroupIter::HardLink);
+  hiter.next();
+  hdf5pp::Group g2 = hiter.next();
+  if (not g2.hasChild("sub") or hiter.next().valid()) throw std::runtime_error("GroupIter returned unexpected groups");
+}
+
+void test_external_link() {
+  TestFile extname(".h5");
+  {
+    hdf5pp::File h5ext = hdf5pp::File::create(extname.fname,hdf5pp::File::Truncate);
+    h5ext.createGroup("a").createDataSet<int32_t>("x", hdf5pp::DataSpace::makeSimple(3, 3));
+  }
+
+  // same path exists in both files, dataset in this file is cached first
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group a = h5out.createGroup("a");
+  a.createDataSet<int32_t>("x", hdf5pp::DataSpace::makeSimple(7, 7));
+  hdf5pp::Group top = h5out.createGroup("top");
+  if (H5Lcreate_external(extname.fname.c_str(), "/a", top.id(), "ext", H5P_DEFAULT, H5P_DEFAULT) < 0) {
+    throw std::runtime_error("H5Lcreate_external failed");
+  }
+  if (a.openDataSet("x").dataSpace().size() != 7) throw std::runtime_error("dataset has unexpected size");
+
+  // external group does not share caches with this file
+  hdf5pp::GroupIter giter(top);
+  hdf5pp::Group ext = giter.next();
+  if (not ext.valid() or giter.next().valid()) throw std::runtime_error("GroupIter did not return external group");
+  if (ext.openDataSet("x").dataSpace().size() != 3) throw std::runtime_error("external dataset has unexpected size");
+  if (not ext.hasChild("x") or ext.hasChild("y")) throw std::runtime_error("hasChild failed in external group");
+  if (a.openDataSet("x").dataSpace().size() != 7) throw std::runtime_error("dataset has unexpected size");
+}
+
+int main() {
+  test_link_iter();
+  test_external_link();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
@@ -5,26 +5,7 @@
 #include <vector>
 #include <string>
 #include <iostream>
-
-// helper class to create a test file name 
-// for a test, and remove it in the desctructor
-struct TestFile {
-  std::string fname;
-  TestFile(std::string ext="") {
-    fname = std::tmpnam(NULL);
-    if (fname.size()==0) throw std::runtime_error("std::tmpname returned null string");
-    fname += ext;
-  }
-  
-  ~TestFile() {
-    if (FILE * f = fopen(fname.c_str(), "r")) {
-      fclose(f);
-      if( 0 != std::remove(fname.c_str())) {
-        perror( "Error deleting file" );
-      }
-    }
-  };
-};
+#include "TestUtils.h"
 
     
 void test_store() {
@@ -0,0 +1,48 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/DataSetAppender.h"
+#include "hdf5pp/DataSetReader.h"
+#include "hdf5pp/Utils.h"
+#include <stdexcept>
+#include <iostream>
+#include "TestUtils.h"
+
+void test_reader() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  hdf5pp::Type type = hdf5pp::TypeTraits<int32_t>::stored_type();
+  hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "data", type, 64, 2, 1, true);
+  {
+    hdf5pp::Appender<int32_t> app(ds);
+    for (int32_t i = 0; i != 1000; ++ i) app.append(i);
+  }
+
+  // sequential access reads one chunk at a time
+  for (int background = 0; background != 2; ++ background) {
+    hdf5pp::Reader<int32_t> reader(ds, 0, background);
+    if (reader.size() != 1000) throw std::runtime_error("reader has unexpected size");
+    for (int32_t i = 0; i != 1000; ++ i) {
+      if (reader.read(i) != i) throw std::runtime_error("reader returned unexpected data");
+    }
+    if (reader.reads() != (1000+63)/64) throw std::runtime_error("unexpected number of reads");
+  }
+
+  // random access reads single records
+  hdf5pp::Reader<int32_t> reader(ds, 100);
+  if (reader.at(500) != 500 or reader.at(10) != 10 or reader.at(900) != 900) {
+    throw std::runtime_error("reader returned unexpected data");
+  }
+  if (reader.reads() != 3) throw std::runtime_error("unexpected number of reads");
+  if (reader.at(901) != 901 or reader.at(999) != 999 or reader.at(950) != 950) {
+    throw std::runtime_error("reader returned unexpected data");
+  }
+  if (reader.reads() != 4) throw std::runtime_error("unexpected number of reads");
+}
+
+int main() {
+  test_reader();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,207 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/CompoundTraits.h"
+#include "hdf5pp/CompoundType.h"
+#include "hdf5pp/DataSetAppender.h"
+#include "hdf5pp/DataSetReader.h"
+#include "hdf5pp/TypeCache.h"
+#include "hdf5pp/TypeRegistry.h"
+#include "hdf5pp/Utils.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include "TestUtils.h"
+
+namespace test {
+struct Record {
+  int8_t flag;
+  double pos[3];
+  int16_t id;
+};
+}
+HDF5PP_COMPOUND(test::Record, (flag)(pos)(id))
+
+void test_compound() {
+  hdf5pp::Type native = hdf5pp::TypeTraits<test::Record>::native_type();
+  hdf5pp::Type stored = hdf5pp::TypeTraits<test::Record>::stored_type();
+  if (native.size() != sizeof(test::Record)) throw std::runtime_error("native type has unexpected size");
+  if (stored.size() != 1+3*8+2) throw std::runtime_error("stored type is not packed");
+  if (hdf5pp::TypeTraits<test::Record>::native_type().id() != native.id()) {
+    throw std::runtime_error("native type is not cached");
+  }
+
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+  hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "data", stored, 16, 2, -1, false);
+  {
+    hdf5pp::Appender<test::Record> app(ds);
+    for (int i = 0; i != 100; ++ i) {
+      test::Record rec = { int8_t(i % 2), { i*1., i*2., i*3. }, int16_t(i) };
+      app.append(rec);
+    }
+  }
+
+  hdf5pp::Reader<test::Record> reader(ds);
+  for (int i = 0; i != 100; ++ i) {
+    const test::Record& rec = reader.at(i);
+    if (rec.flag != i % 2 or rec.pos[2] != i*3. or rec.id != i) {
+      throw std::runtime_error("compound record has unexpected data");
+    }
+  }
+}
+
+void test_conversion() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  hdf5pp::Type native = hdf5pp::TypeTraits<int32_t>::native_type();
+  hdf5pp::DataSet ds = hdf5pp::Utils::createDataset(group, "native", native, 16, 2, -1, false);
+  hdf5pp::DataSet dsbe = hdf5pp::Utils::createDataset(group, "be", hdf5pp::Type::LockedType(H5T_STD_I32BE), 16, 2, -1, false);
+  if (not ds.noopConversion(native)) throw std::runtime_error("unexpected conversion for native type");
+  if (dsbe.noopConversion(native)) throw std::runtime_error("conversion not detected for big-endian type");
+
+  for (int32_t i = 0; i != 10; ++ i) {
+    hdf5pp::Utils::storeAt(group, "native", i, -1);
+    hdf5pp::Utils::storeAt(group, "be", i, -1);
+  }
+  check_data(group, "be", 10);
+
+  // group caches datasets, counters include all reads and writes above
+  ds = group.openDataSet("native");
+  dsbe = group.openDataSet("be");
+  unsigned long count = dsbe.conversions();
+  uint64_t bytes = dsbe.convertedBytes();
+  hdf5pp::Utils::readDataSet<int32_t>(ds, 5);
+  hdf5pp::Utils::readDataSet<int32_t>(dsbe, 5);
+  if (ds.conversions() != 0 or ds.convertedBytes() != 0) throw std::runtime_error("unexpected conversion count");
+  if (dsbe.conversions() != count+1 or dsbe.convertedBytes() != bytes+4) {
+    throw std::runtime_error("unexpected conversion count");
+  }
+
+  // strict mode
+  hdf5pp::DataSet::setConversionCheck(hdf5pp::DataSet::ConversionThrow);
+  hdf5pp::Utils::readDataSet<int32_t>(ds, 5);
+  bool thrown = false;
+  try {
+    hdf5pp::Utils::readDataSet<int32_t>(dsbe, 5);
+  } catch (const hdf5pp::Hdf5TypeConversion&) {
+    thrown = true;
+  }
+  hdf5pp::DataSet::setConversionCheck(hdf5pp::DataSet::ConversionAllow);
+  if (not thrown) throw std::runtime_error("conversion exception was not thrown");
+}
+
+hdf5pp::Type make_record_type() {
+  hdf5pp::CompoundType type = hdf5pp::CompoundType::compoundType<test::Record>();
+  type.insert_native<int16_t>("id", offsetof(test::Record, id));
+  return type;
+}
+
+namespace test {
+struct Point {
+  float x;
+  float y;
+};
+struct Event {
+  double time;
+  Point pos;
+};
+}
+
+hdf5pp::Type make_point_type() {
+  hdf5pp::CompoundType type = hdf5pp::CompoundType::compoundType<test::Point>();
+  type.insert_native<float>("x", offsetof(test::Point, x));
+  type.insert_native<float>("y", offsetof(test::Point, y));
+  return type;
+}
+
+// compound type with a member of other registered type
+hdf5pp::Type make_event_type() {
+  hdf5pp::CompoundType type = hdf5pp::CompoundType::compoundType<test::Event>();
+  type.insert_native<double>("time", offsetof(test::Event, time));
+  type.insert("pos", offsetof(test::Event, pos), hdf5pp::TypeRegistry::get(&make_point_type));
+  return type;
+}
+
+// looks up registered types, no HDF5 calls are made for known types
+void lookup_types(hid_t recordId, hid_t arrayId, bool* ok) {
+  for (int i = 0; i != 10000; ++ i) {
+    if (hdf5pp::TypeRegistry::get(&make_record_type).id() != recordId) *ok = false;
+    if (hdf5pp::TypeTraits<int32_t>::native_type(4).id() != arrayId) *ok = false;
+  }
+}
+
+void test_registry() {
+  hdf5pp::TypeRegistry::warmup();
+  hdf5pp::TypeRegistry::add(&make_record_type);
+  hid_t recordId = hdf5pp::TypeRegistry::get(&make_record_type).id();
+  hid_t arrayId = hdf5pp::TypeTraits<int32_t>::native_type(4).id();
+
+  bool ok[4] = { true, true, true, true };
+  boost::thread_group threads;
+  for (int i = 0; i != 4; ++ i) threads.create_thread(boost::bind(&lookup_types, recordId, arrayId, &ok[i]));
+  threads.join_all();
+  for (int i = 0; i != 4; ++ i) {
+    if (not ok[i]) throw std::runtime_error("registry returned different type");
+  }
+
+  // factory of nested compound registers its member type
+  size_t size = hdf5pp::TypeRegistry::size();
+  hdf5pp::Type event = hdf5pp::TypeRegistry::get(&make_event_type);
+  if (hdf5pp::TypeRegistry::get(&make_event_type).id() != event.id()) {
+    throw std::runtime_error("registry returned different type");
+  }
+  if (hdf5pp::TypeRegistry::size() != size+2) throw std::runtime_error("registry has unexpected size");
+  hid_t member = H5Tget_member_type(event.id(), 1);
+  bool same = H5Tequal(member, hdf5pp::TypeRegistry::get(&make_point_type).id()) > 0;
+  H5Tclose(member);
+  if (not same) throw std::runtime_error("nested compound has unexpected member type");
+}
+
+// true if type cannot be modified
+bool is_locked(const hdf5pp::Type& type) {
+  herr_t stat;
+  H5E_BEGIN_TRY {
+    stat = H5Tset_size(type.id(), H5Tget_size(type.id()));
+  } H5E_END_TRY;
+  return stat < 0;
+}
+
+void test_type_cache() {
+  // repeated requests return the same locked type
+  hdf5pp::Type base = hdf5pp::TypeTraits<int32_t>::native_type();
+  hsize_t dims[] = { 3, 4 };
+  hsize_t other[] = { 4, 3 };
+  hdf5pp::ArrayType array = hdf5pp::TypeCache::arrayType(base, 2, dims);
+  if (hdf5pp::TypeCache::arrayType(base, 2, dims).id() != array.id()) throw std::runtime_error("array type is not cached");
+  if (hdf5pp::TypeCache::arrayType(base, 2, other).id() == array.id()) throw std::runtime_error("array types with different dims are the same");
+  if (hdf5pp::TypeCache::arrayType(base, 1, dims).id() == array.id()) throw std::runtime_error("array types with different rank are the same");
+  if (not is_locked(array)) throw std::runtime_error("array type is not locked");
+
+  hdf5pp::Type str = hdf5pp::TypeCache::stringType(16);
+  if (hdf5pp::TypeCache::stringType(16).id() != str.id()) throw std::runtime_error("string type is not cached");
+  if (hdf5pp::TypeCache::stringType(17).id() == str.id()) throw std::runtime_error("string types of different size are the same");
+  if (not is_locked(str)) throw std::runtime_error("string type is not locked");
+
+  // TypeTraits take derived types from cache
+  if (hdf5pp::TypeTraits<const char*>::native_type(16).id() != str.id()) throw std::runtime_error("string trait type is not cached");
+  if (not is_locked(hdf5pp::TypeTraits<const char*>::native_type())) throw std::runtime_error("variable string type is not locked");
+  if (not is_locked(hdf5pp::TypeTraits<const char*>::stored_type(8))) throw std::runtime_error("string trait type is not locked");
+  if (hdf5pp::TypeTraits<int32_t>::native_type(12).id() != hdf5pp::TypeCache::arrayType(base, 12).id()) {
+    throw std::runtime_error("array trait type is not cached");
+  }
+}
+
+int main() {
+  test_type_cache();
+  test_compound();
+  test_conversion();
+  test_registry();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}
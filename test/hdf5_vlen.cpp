@@ -0,0 +1,89 @@
+#include "hdf5pp/File.h"
+#include "hdf5pp/Utils.h"
+#include "hdf5pp/VlenArena.h"
+#include "hdf5pp/VlenType.h"
+#include <stdexcept>
+#include <vector>
+#include <iostream>
+#include "TestUtils.h"
+
+void test_vlen_arena() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  // rows of different length, row i has i elements
+  const int nrows = 100;
+  std::vector<int32_t> values(nrows*nrows);
+  std::vector<hvl_t> rows(nrows);
+  for (int i = 0; i != nrows; ++ i) {
+    for (int j = 0; j != i; ++ j) values[i*nrows+j] = i*1000+j;
+    rows[i].len = i;
+    rows[i].p = &values[i*nrows];
+  }
+  hdf5pp::Type vtype = hdf5pp::VlenType::vlenType(hdf5pp::TypeTraits<int32_t>::native_type());
+  hdf5pp::DataSpace dsp = hdf5pp::DataSpace::makeSimple(nrows, nrows);
+  hdf5pp::DataSet ds = group.createDataSet("ragged", vtype, dsp);
+  ds.store(dsp, hdf5pp::DataSpace::makeAll(), &rows.front(), vtype);
+
+  // small region limit to make several regions
+  std::vector<ndarray<int32_t, 1> > arrays;
+  {
+    hdf5pp::VlenArena arena(4096, 8192);
+    for (int i = 0; i != nrows; ++ i) {
+      arrays.push_back(hdf5pp::Utils::readNdarray<int32_t, 1>(ds, arena, i));
+    }
+    if (arena.regions() < 2) throw std::runtime_error("arena made too few regions");
+  }
+
+  // arrays keep their regions alive after arena is gone
+  for (int i = 0; i != nrows; ++ i) {
+    if (int(arrays[i].size()) != i) throw std::runtime_error("VLEN array has unexpected size");
+    for (int j = 0; j != i; ++ j) {
+      if (arrays[i].data()[j] != i*1000+j) throw std::runtime_error("VLEN array has unexpected data");
+    }
+  }
+}
+
+// make rows begin..end-1, row i has i%7 elements
+hdf5pp::RaggedArray<int32_t> make_ragged(int begin, int end) {
+  hdf5pp::RaggedArray<int32_t> data;
+  unsigned oshape[] = { unsigned(end - begin + 1) };
+  data.offsets = ndarray<uint64_t, 1>(oshape);
+  data.offsets.data()[0] = 0;
+  for (int i = begin; i != end; ++ i) data.offsets.data()[i-begin+1] = data.offsets.data()[i-begin] + i % 7;
+  unsigned vshape[] = { unsigned(data.offsets.data()[end-begin]) };
+  data.values = ndarray<int32_t, 1>(vshape);
+  for (int i = begin; i != end; ++ i) {
+    for (size_t j = 0; j != data.rowSize(i-begin); ++ j) data.row(i-begin)[j] = i*100 + j;
+  }
+  return data;
+}
+
+void test_ragged() {
+  TestFile fname(".h5");
+  hdf5pp::File h5out = hdf5pp::File::create(fname.fname,hdf5pp::File::Truncate);
+  hdf5pp::Group group = h5out.createGroup("group");
+
+  hdf5pp::Type vtype = hdf5pp::VlenType::vlenType(hdf5pp::TypeTraits<int32_t>::stored_type());
+  hdf5pp::Utils::createDataset(group, "ragged", vtype, 16, 2, -1, false);
+  hdf5pp::Utils::storeRagged(group, "ragged", make_ragged(0, 50));
+  hdf5pp::Utils::storeRagged(group, "ragged", make_ragged(50, 100));
+
+  hdf5pp::RaggedArray<int32_t> data = hdf5pp::Utils::readRagged<int32_t>(group, "ragged", 10, 1000);
+  if (data.size() != 90) throw std::runtime_error("readRagged returned unexpected size");
+  for (int i = 10; i != 100; ++ i) {
+    if (data.rowSize(i-10) != size_t(i % 7)) throw std::runtime_error("readRagged returned unexpected row size");
+    for (size_t j = 0; j != data.rowSize(i-10); ++ j) {
+      if (data.row(i-10)[j] != int32_t(i*100 + j)) throw std::runtime_error("readRagged returned unexpected data");
+    }
+  }
+}
+
+int main() {
+  test_vlen_arena();
+  test_ragged();
+
+  std::cout << "tests passed" << std::endl;
+  return 0;
+}